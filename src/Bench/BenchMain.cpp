@@ -0,0 +1,177 @@
+#include "SpriteSweep.hpp"
+#include "TextureCacheBench.hpp"
+#include "TileMapBench.hpp"
+#include "../GameLoop.hpp"
+
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Comma separated values of an option, "1000,10000"
+template <typename T>
+static std::vector<T> ParseList(const std::string& text)
+{
+	std::vector<T> values;
+	std::stringstream stream{ text };
+	for (std::string item; std::getline(stream, item, ',');)
+	{
+		if constexpr (std::is_same_v<T, int>)
+			values.push_back(std::stoi(item));
+		else
+			values.push_back(std::stof(item));
+	}
+
+	return values;
+}
+
+// Sprite throughput benchmark, every option takes a value:
+// --counts 1000,10000,...    sprite counts
+// --textures 1,4,...         texture diversity
+// --overdraw 1,4,...         summed sprite area over the screen area
+// --dynamic 0,0.5,...        share of the sprites moving every frame
+// --backends quad,batched,...
+// --depth-modes painter,split   every backend runs in each (packed-flat in painter only), painter only by default
+// --frames N                 measured frames per run, 60 by default
+// --csv path, --json path    results, sprite_sweep.csv and sprite_sweep.json by default
+// Flags: --full measures every combination instead of one axis at a time, --headless renders without a window,
+// --palette keeps the color maps of the sprites as palettized textures,
+// --texture-cache measures the TextureManager evicting and reloading the sprites instead (see TextureCacheBench),
+// --tile-map draws maps of 80, 160 and 320 tiles across with the TileRenderer and as sprites instead (see TileMapBench)
+int main(int argc, char* argv[])
+{
+	try
+	{
+		GameEngine::SweepSettings settings{};
+		std::string csvPath{ "sprite_sweep.csv" };
+		std::string jsonPath{ "sprite_sweep.json" };
+		bool headless{};
+		bool textureCache{};
+		bool tileMap{};
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option{ argv[i] };
+			if (option == "--full")
+			{
+				settings.fullProduct = true;
+				continue;
+			}
+			if (option == "--headless")
+			{
+				headless = true;
+				continue;
+			}
+			if (option == "--palette")
+			{
+				settings.paletteTextures = true;
+				continue;
+			}
+			if (option == "--texture-cache")
+			{
+				textureCache = true;
+				continue;
+			}
+			if (option == "--tile-map")
+			{
+				tileMap = true;
+				continue;
+			}
+
+			if (i + 1 >= argc)
+				throw std::runtime_error("Missing value of " + option);
+			const std::string value{ argv[++i] };
+
+			if (option == "--counts")
+				settings.spriteCounts = ParseList<int>(value);
+			else if (option == "--textures")
+				settings.textureCounts = ParseList<int>(value);
+			else if (option == "--overdraw")
+				settings.overdraws = ParseList<float>(value);
+			else if (option == "--dynamic")
+				settings.dynamicRatios = ParseList<float>(value);
+			else if (option == "--frames")
+				settings.frames = std::stoi(value);
+			else if (option == "--csv")
+				csvPath = value;
+			else if (option == "--json")
+				jsonPath = value;
+			else if (option == "--depth-modes")
+			{
+				settings.depthModes.clear();
+				std::stringstream stream{ value };
+				for (std::string name; std::getline(stream, name, ',');)
+				{
+					std::optional<GameEngine::Renderer::DepthMode> mode = GameEngine::Renderer::ParseDepthMode(name);
+					if (!mode)
+						throw std::runtime_error("Unknown depth mode: " + name);
+
+					settings.depthModes.push_back(*mode);
+				}
+			}
+			else if (option == "--backends")
+			{
+				settings.backends.clear();
+				std::stringstream stream{ value };
+				for (std::string name; std::getline(stream, name, ',');)
+				{
+					std::optional<GameEngine::SpriteBackend> backend = GameEngine::ParseSpriteBackend(name);
+					if (!backend)
+						throw std::runtime_error("Unknown sprite backend: " + name);
+
+					settings.backends.push_back(*backend);
+				}
+			}
+			else
+				throw std::runtime_error("Unknown option: " + option);
+		}
+
+		constexpr int viewWidth{ 1280 };
+		constexpr int viewHeight{ 720 };
+		GLFWwindow* window = GameEngine::GraphicsInit(viewWidth, viewHeight, headless);
+		if (window != nullptr)
+			glfwSwapInterval(0);
+
+		if (textureCache)
+		{
+			GameEngine::TextureCacheBenchSettings cacheSettings{};
+			if (settings.frames != GameEngine::SweepSettings{}.frames)
+				cacheSettings.frames = settings.frames;
+
+			const GameEngine::TextureCacheBenchResult result{ GameEngine::RunTextureCacheBench(cacheSettings, GameEngine::ResourcesPath + "sprites/") };
+			std::cout << GameEngine::FormatTextureCacheResult(result);
+			GameEngine::GraphicsShutdown();
+			return 0;
+		}
+
+		if (tileMap)
+		{
+			GameEngine::TileMapBenchSettings tileSettings{};
+			tileSettings.frames = settings.frames;
+
+			GameEngine::RunTileMapBench(tileSettings, viewWidth, viewHeight, GameEngine::ShaderPath, GameEngine::ResourcesPath + "sprites/tilesets/");
+			GameEngine::GraphicsShutdown();
+			return 0;
+		}
+
+		const std::vector<GameEngine::SweepResult> results = GameEngine::RunSpriteSweep(settings, viewWidth, viewHeight,
+			GameEngine::ShaderPath, GameEngine::ResourcesPath + "sprites/");
+
+		GameEngine::WriteSweepCsv(csvPath, results);
+		GameEngine::WriteSweepJson(jsonPath, results);
+		std::cout << "Results saved to " << csvPath << " and " << jsonPath << '\n';
+
+		GameEngine::GraphicsShutdown();
+	}
+
+	catch (const std::exception& except)
+	{
+		std::cout << "Benchmark failed:\n" << except.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,330 @@
+#include "SpriteSweep.hpp"
+#include "../Timer.hpp"
+#include "../GameEngine/Camera2D.hpp"
+#include "../GameEngine/SpriteQueue.hpp"
+#include "../GameEngine/JobSystem.hpp"
+#include "../GameEngine/Renderer.hpp"
+#include "../GameEngine/Texture.hpp"
+#include "../GameEngine/GpuProfiler.hpp"
+#include "../GameEngine/TraceWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+namespace GameEngine
+{
+	std::vector<std::string> FindSpriteImages(const std::string& spritePath)
+	{
+		std::vector<std::string> images;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator{ spritePath })
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".png")
+				images.push_back(entry.path().generic_string());
+		}
+
+		std::sort(images.begin(), images.end());
+		return images;
+	}
+
+	// Sprites of random sizes around the one that gives the requested overdraw, all of them on screen
+	static std::vector<Sprite> GenerateScene(const SweepScene& scene, float aspectRatio)
+	{
+		const float visibleArea{ 2.0f * aspectRatio * 2.0f };
+		const float meanSize{ std::sqrt(scene.overdraw * visibleArea / static_cast<float>(scene.spriteCount)) };
+
+		std::mt19937 generator{ 41 };
+		std::uniform_real_distribution<float> xDist{ -aspectRatio, aspectRatio };
+		std::uniform_real_distribution<float> yDist{ -1.0f, 1.0f };
+		std::uniform_real_distribution<float> sizeDist{ 0.5f * meanSize, 1.5f * meanSize };
+		std::uniform_real_distribution<float> angleDist{ 0.0f, 6.2831853f };
+		std::uniform_int_distribution<int> colorDist{ 128, 255 };
+
+		std::vector<Sprite> sprites(static_cast<std::size_t>(scene.spriteCount));
+		for (Sprite& sprite : sprites)
+		{
+			const float size{ sizeDist(generator) };
+
+			sprite.position = { xDist(generator), yDist(generator), 0.0f };
+			sprite.size = { size, size };
+			sprite.rotation = angleDist(generator);
+			sprite.tint = PackColor(
+				static_cast<std::uint8_t>(colorDist(generator)),
+				static_cast<std::uint8_t>(colorDist(generator)),
+				static_cast<std::uint8_t>(colorDist(generator)));
+		}
+
+		return sprites;
+	}
+
+	static SweepResult MeasureScene(const SweepSettings& settings, const SweepScene& scene, SpriteBackend backend,
+		std::vector<Sprite> sprites, std::vector<Texture>& textures, const Camera2D& camera, JobSystem& jobs, const std::string& shaderPath)
+	{
+		std::unique_ptr<SpriteRenderer> renderer = CreateSpriteRenderer(backend, shaderPath);
+		GpuProfiler gpuProfiler{};
+
+		// One queue per texture, like a renderer that batches by texture after sorting
+		const std::size_t textureCount{ static_cast<std::size_t>(scene.textureCount) };
+		std::vector<SpriteQueue> queues(textureCount);
+		for (SpriteQueue& queue : queues)
+			queue.VisibleArea(SpriteQueue::VisibleArea(camera.View(), camera.Projection()));
+
+		const std::size_t dynamicCount{ static_cast<std::size_t>(std::lround(scene.dynamicRatio * static_cast<float>(sprites.size()))) };
+
+		SweepResult result{ scene, backend, Renderer::GetDepthMode() };
+		Timer<double> runTimer{};
+		Timer<double> stepTimer{};
+		Timer<double> frameTimer{};
+
+		for (int frame = -settings.warmupFrames; frame < settings.frames; ++frame)
+		{
+			if (frame == 0)
+			{
+				renderer->ResetStats();
+				gpuProfiler.ResetStats();
+				runTimer.Reset();
+			}
+			else if (frame > 0 && runTimer.Elapsed() > settings.maxRunSeconds)
+				break;
+
+			gpuProfiler.BeginFrame();
+			frameTimer.Reset();
+
+			// The dynamic sprites spin and drift up and down
+			stepTimer.Reset();
+			const float drift{ (frame / 30) % 2 == 0 ? 0.001f : -0.001f };
+			for (std::size_t i = 0; i < dynamicCount; ++i)
+			{
+				sprites[i].rotation += 0.01f;
+				sprites[i].position.y += drift;
+			}
+			const double updateTime{ stepTimer.Elapsed() };
+
+			stepTimer.Reset();
+			for (SpriteQueue& queue : queues)
+				queue.Clear();
+			for (std::size_t i = 0; i < sprites.size(); ++i)
+			{
+				const std::size_t texture{ i % textureCount };
+				queues[texture].Submit(sprites[i], 0, static_cast<std::uint32_t>(i), textures[texture].Alpha());
+			}
+			for (SpriteQueue& queue : queues)
+				queue.Sort(&jobs);
+			const double sortTime{ stepTimer.Elapsed() };
+
+			Renderer::BindOutputFramebuffer();
+			Renderer::Clear();
+
+			stepTimer.Reset();
+			gpuProfiler.BeginScope("sprites");
+			for (std::size_t texture = 0; texture < textureCount; ++texture)
+			{
+				textures[texture].Bind(GL_TEXTURE0);
+				renderer->PaletteMode(textures[texture].Palettized());
+				queues[texture].Draw(*renderer, camera.View(), camera.Projection(), textures[texture].PremultipliedAlpha());
+			}
+			gpuProfiler.EndScope();
+			const double cpuTime{ stepTimer.Elapsed() };
+
+			gpuProfiler.EndFrame();
+			glFinish();
+			const double frameTime{ frameTimer.Elapsed() };
+
+			if (frame >= 0)
+			{
+				++result.frames;
+				result.updateMs += updateTime * 1000.0;
+				result.sortMs += sortTime * 1000.0;
+				result.cpuMs += cpuTime * 1000.0;
+				result.frameMs += frameTime * 1000.0;
+			}
+		}
+
+		// Collects the frames still in flight
+		gpuProfiler.BeginFrame();
+		gpuProfiler.EndFrame();
+
+		const double frames{ static_cast<double>(std::max(result.frames, 1)) };
+		result.updateMs /= frames;
+		result.sortMs /= frames;
+		result.cpuMs /= frames;
+		result.frameMs /= frames;
+		result.gpuMs = gpuProfiler.Passes().empty() ? 0.0 : gpuProfiler.Passes().front().MeanMs();
+		result.drawCalls = static_cast<double>(renderer->Stats().drawCalls) / frames;
+		result.bytesUploaded = static_cast<double>(renderer->Stats().bytesUploaded) / frames;
+		return result;
+	}
+
+	std::vector<SweepScene> SweepScenes(const SweepSettings& settings)
+	{
+		std::vector<SweepScene> scenes;
+		auto add = [&scenes](const SweepScene& scene)
+		{
+			const bool known = std::any_of(scenes.begin(), scenes.end(), [&scene](const SweepScene& other)
+			{
+				return other.spriteCount == scene.spriteCount && other.textureCount == scene.textureCount
+					&& other.overdraw == scene.overdraw && other.dynamicRatio == scene.dynamicRatio;
+			});
+
+			if (!known)
+				scenes.push_back(scene);
+		};
+
+		if (settings.fullProduct)
+		{
+			for (int spriteCount : settings.spriteCounts)
+				for (int textureCount : settings.textureCounts)
+					for (float overdraw : settings.overdraws)
+						for (float dynamicRatio : settings.dynamicRatios)
+							add({ spriteCount, textureCount, overdraw, dynamicRatio });
+
+			return scenes;
+		}
+
+		add(settings.base);
+		for (int spriteCount : settings.spriteCounts)
+			add({ spriteCount, settings.base.textureCount, settings.base.overdraw, settings.base.dynamicRatio });
+		for (int textureCount : settings.textureCounts)
+			add({ settings.base.spriteCount, textureCount, settings.base.overdraw, settings.base.dynamicRatio });
+		for (float overdraw : settings.overdraws)
+			add({ settings.base.spriteCount, settings.base.textureCount, overdraw, settings.base.dynamicRatio });
+		for (float dynamicRatio : settings.dynamicRatios)
+			add({ settings.base.spriteCount, settings.base.textureCount, settings.base.overdraw, dynamicRatio });
+
+		return scenes;
+	}
+
+	std::vector<SweepResult> RunSpriteSweep(const SweepSettings& settings, int viewWidth, int viewHeight,
+		const std::string& shaderPath, const std::string& spritePath)
+	{
+		const std::vector<SweepScene> scenes{ SweepScenes(settings) };
+		for (const SweepScene& scene : scenes)
+		{
+			if (scene.spriteCount <= 0 || scene.textureCount <= 0 || scene.overdraw <= 0.0f)
+				throw std::runtime_error("RunSpriteSweep error: sprite count, texture count and overdraw have to be positive");
+		}
+
+		const std::vector<std::string> images{ FindSpriteImages(spritePath) };
+		if (images.empty())
+			throw std::runtime_error("RunSpriteSweep error: no PNG sprites in " + spritePath);
+
+		// Past the number of files the images repeat, still as separate textures
+		const auto maxTextures = std::max_element(scenes.begin(), scenes.end(), [](const SweepScene& a, const SweepScene& b)
+		{
+			return a.textureCount < b.textureCount;
+		});
+		std::vector<Texture> textures;
+		textures.reserve(static_cast<std::size_t>(maxTextures->textureCount));
+		for (int i = 0; i < maxTextures->textureCount; ++i)
+		{
+			const std::string& image{ images[static_cast<std::size_t>(i) % images.size()] };
+			std::optional<IndexedImage> indexed;
+			if (settings.paletteTextures)
+				indexed = LoadIndexedImage(image);
+
+			if (indexed)
+				textures.emplace_back(*indexed);
+			else
+				textures.emplace_back(LoadImage(image, 4), GL_NEAREST);
+		}
+
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		glViewport(0, 0, viewWidth, viewHeight);
+
+		const float aspectRatio{ static_cast<float>(viewWidth) / static_cast<float>(viewHeight) };
+		const Camera2D camera{ { 0.0f, 0.0f, 3.0f }, aspectRatio, 0.1f, 100.0f };
+		JobSystem jobs{};
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		std::vector<SweepResult> results;
+		results.reserve(scenes.size() * settings.backends.size());
+		for (const SweepScene& scene : scenes)
+		{
+			const std::vector<Sprite> sprites{ GenerateScene(scene, aspectRatio) };
+			for (Renderer::DepthMode depthMode : settings.depthModes)
+			{
+				Renderer::SetDepthMode(depthMode);
+
+				for (SpriteBackend backend : settings.backends)
+				{
+					if (depthMode != Renderer::DepthMode::Painter2D && !KeepsDepth(backend))
+						continue;
+
+					results.push_back(MeasureScene(settings, scene, backend, sprites, textures, camera, jobs, shaderPath));
+					std::cout << (results.size() == 1 ? FormatSweepTable(results) : FormatSweepRow(results.back())) << std::flush;
+				}
+			}
+		}
+
+		return results;
+	}
+
+	std::string FormatSweepTable(const std::vector<SweepResult>& results)
+	{
+		std::string table{ std::format("{:>9}{:>6}{:>7}{:>6}  {:<16}{:<9}{:>8}{:>10}{:>10}{:>10}{:>10}{:>10}{:>12}\n",
+			"sprites", "tex", "over", "dyn", "backend", "depth", "frames", "update ms", "sort ms", "cpu ms", "gpu ms", "draws", "KiB/frame") };
+
+		for (const SweepResult& result : results)
+			table += FormatSweepRow(result);
+
+		return table;
+	}
+
+	std::string FormatSweepRow(const SweepResult& result)
+	{
+		return std::format("{:>9}{:>6}{:>7.1f}{:>6.2f}  {:<16}{:<9}{:>8}{:>10.3f}{:>10.3f}{:>10.3f}{:>10.3f}{:>10.0f}{:>12.1f}\n",
+			result.scene.spriteCount, result.scene.textureCount, result.scene.overdraw, result.scene.dynamicRatio,
+			ToString(result.backend), Renderer::ToString(result.depthMode), result.frames, result.updateMs, result.sortMs, result.cpuMs, result.gpuMs,
+			result.drawCalls, result.bytesUploaded / 1024.0);
+	}
+
+	void WriteSweepCsv(const std::string& path, const std::vector<SweepResult>& results)
+	{
+		std::ofstream file{ path };
+		if (!file)
+			throw std::runtime_error("WriteSweepCsv error: can't open " + path);
+
+		file << "sprites,textures,overdraw,dynamic_ratio,backend,depth_mode,frames,update_ms,sort_ms,cpu_ms,gpu_ms,frame_ms,draw_calls,bytes_uploaded\n";
+		for (const SweepResult& result : results)
+		{
+			file << std::format("{},{},{:.2f},{:.2f},{},{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.1f},{:.0f}\n",
+				result.scene.spriteCount, result.scene.textureCount, result.scene.overdraw, result.scene.dynamicRatio,
+				ToString(result.backend), Renderer::ToString(result.depthMode), result.frames, result.updateMs, result.sortMs, result.cpuMs, result.gpuMs,
+				result.frameMs, result.drawCalls, result.bytesUploaded);
+		}
+	}
+
+	void WriteSweepJson(const std::string& path, const std::vector<SweepResult>& results)
+	{
+		std::ofstream file{ path };
+		if (!file)
+			throw std::runtime_error("WriteSweepJson error: can't open " + path);
+
+		const char* glRenderer{ reinterpret_cast<const char*>(glGetString(GL_RENDERER)) };
+		const char* glVersion{ reinterpret_cast<const char*>(glGetString(GL_VERSION)) };
+
+		file << std::format("{{\"renderer\":\"{}\",\"version\":\"{}\",\"results\":[",
+			TraceWriter::Escape(glRenderer != nullptr ? glRenderer : ""), TraceWriter::Escape(glVersion != nullptr ? glVersion : ""));
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			const SweepResult& result = results[i];
+			file << std::format("{}\n{{\"sprites\":{},\"textures\":{},\"overdraw\":{:.2f},\"dynamicRatio\":{:.2f},\"backend\":\"{}\",\"depthMode\":\"{}\",\"frames\":{},"
+				"\"updateMs\":{:.4f},\"sortMs\":{:.4f},\"cpuMs\":{:.4f},\"gpuMs\":{:.4f},\"frameMs\":{:.4f},\"drawCalls\":{:.1f},\"bytesUploaded\":{:.0f}}}",
+				i == 0 ? "" : ",", result.scene.spriteCount, result.scene.textureCount, result.scene.overdraw, result.scene.dynamicRatio,
+				ToString(result.backend), Renderer::ToString(result.depthMode), result.frames, result.updateMs, result.sortMs, result.cpuMs,
+				result.gpuMs, result.frameMs, result.drawCalls, result.bytesUploaded);
+		}
+
+		file << "\n]}\n";
+		if (!file)
+			throw std::runtime_error("WriteSweepJson error: failed to write " + path);
+	}
+}
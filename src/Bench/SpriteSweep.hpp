@@ -0,0 +1,83 @@
+#pragma once
+#include "../GameEngine/Renderer.hpp"
+#include "../GameEngine/SpriteRenderer.hpp"
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// One synthetic scene of the sweep
+	struct SweepScene
+	{
+		int spriteCount{ 10000 };
+		int textureCount{ 4 };		// sprites are spread over that many textures, each one breaks the batch
+		float overdraw{ 2.0f };		// summed sprite area over the visible area
+		float dynamicRatio{ 1.0f };	// share of the sprites that move every frame
+	};
+
+	struct SweepSettings
+	{
+		// Every axis is swept around the base scene, the others keep their base value
+		SweepScene base{};
+		std::vector<int> spriteCounts{ 1000, 10000, 100000, 1000000 };
+		std::vector<int> textureCounts{ 1, 4, 16 };
+		std::vector<float> overdraws{ 1.0f, 4.0f, 16.0f };
+		std::vector<float> dynamicRatios{ 0.0f, 0.5f, 1.0f };
+
+		// Every combination of the axes instead, it grows fast
+		bool fullProduct{};
+
+		std::vector<SpriteBackend> backends{ std::begin(AllSpriteBackends), std::end(AllSpriteBackends) };
+
+		// Every backend that keeps the depth runs in each of them, SplitPasses draws the opaque sprites front to back
+		// with depth writes before blending the translucent ones (see SpriteQueue::Draw)
+		std::vector<Renderer::DepthMode> depthModes{ Renderer::DepthMode::Painter2D };
+		int warmupFrames{ 5 };
+		int frames{ 60 };
+
+		// A run stops measuring after that long, the slow backends at 1M sprites would take minutes
+		double maxRunSeconds{ 5.0 };
+
+		// Sprites with a color map are uploaded as R8 indices plus a palette instead of RGBA8
+		bool paletteTextures{};
+	};
+
+	// Per frame averages of one backend in one scene
+	struct SweepResult
+	{
+		SweepScene scene{};
+		SpriteBackend backend{};
+		Renderer::DepthMode depthMode{};
+		int frames{};
+		double updateMs{};		// moving the dynamic sprites
+		double sortMs{};		// submitting, culling and sorting
+		double cpuMs{};			// renderer draw calls, including the uploads
+		double gpuMs{};
+		double frameMs{};		// everything up to glFinish
+		double drawCalls{};
+		double bytesUploaded{};
+	};
+
+	// Sorted PNG files under the directory
+	std::vector<std::string> FindSpriteImages(const std::string& spritePath);
+
+	// Scenes in the order they are measured
+	std::vector<SweepScene> SweepScenes(const SweepSettings& settings);
+
+	// Measures every backend in every scene, the GL context has to be current.
+	// Sprite textures are taken from the PNG files under spritePath
+	// Exceptions: [runtime_error]
+	std::vector<SweepResult> RunSpriteSweep(const SweepSettings& settings, int viewWidth, int viewHeight,
+		const std::string& shaderPath, const std::string& spritePath);
+
+	// Header line and one line per result
+	std::string FormatSweepTable(const std::vector<SweepResult>& results);
+	std::string FormatSweepRow(const SweepResult& result);
+
+	// Exceptions: [runtime_error]
+	void WriteSweepCsv(const std::string& path, const std::vector<SweepResult>& results);
+
+	// The JSON also records the GL renderer and version the numbers come from
+	// Exceptions: [runtime_error]
+	void WriteSweepJson(const std::string& path, const std::vector<SweepResult>& results);
+}
@@ -0,0 +1,121 @@
+#include "TextureCacheBench.hpp"
+#include "SpriteSweep.hpp"
+#include "../Timer.hpp"
+#include "../GameEngine/JobSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace GameEngine
+{
+	TextureCacheBenchResult RunTextureCacheBench(const TextureCacheBenchSettings& settings, const std::string& spritePath)
+	{
+		if (settings.frames <= 0 || settings.texturesPerFrame <= 0 || settings.framesPerStep <= 0 || settings.budgetRatio <= 0.0)
+			throw std::runtime_error("RunTextureCacheBench error: frames, textures per frame, frames per step and budget ratio have to be positive");
+
+		const std::vector<std::string> images{ FindSpriteImages(spritePath) };
+		if (images.empty())
+			throw std::runtime_error("RunTextureCacheBench error: no PNG sprites in " + spritePath);
+
+		// Same contents under other paths
+		const std::filesystem::path copyDirectory{ std::filesystem::temp_directory_path() / "arlekin_texture_cache" };
+		std::filesystem::create_directories(copyDirectory);
+		std::vector<std::string> copies;
+		for (std::size_t i = 0; i < images.size(); ++i)
+		{
+			const std::filesystem::path copy{ copyDirectory / std::format("{}.png", i) };
+			std::filesystem::copy_file(images[i], copy, std::filesystem::copy_options::overwrite_existing);
+			copies.push_back(copy.generic_string());
+		}
+
+		JobSystem loaders{ 2 };
+		TextureManagerSettings managerSettings{};
+		managerSettings.evictAfterFrames = settings.evictAfterFrames;
+		TextureManager manager{ loaders, managerSettings };
+
+		std::vector<TextureHandle> originals;
+		std::vector<TextureHandle> duplicates;
+		for (std::size_t i = 0; i < images.size(); ++i)
+		{
+			originals.push_back(manager.Load(images[i], GL_NEAREST));
+			duplicates.push_back(manager.Load(copies[i], GL_NEAREST));
+		}
+		manager.Flush();
+
+		TextureCacheBenchResult result{};
+		result.textures = static_cast<int>(images.size());
+		result.totalBytes = manager.Stats().residentBytes;
+
+		managerSettings.vramBudget = static_cast<std::size_t>(static_cast<double>(result.totalBytes) * settings.budgetRatio);
+		manager.Settings(managerSettings);
+
+		// Every other texture of the window through the copy, both paths stay in use
+		const std::size_t count{ images.size() };
+		auto visible = [&](int frame, int i) -> const TextureHandle&
+		{
+			const std::size_t index{ (static_cast<std::size_t>(frame / settings.framesPerStep) + static_cast<std::size_t>(i)) % count };
+			return i % 2 == 0 ? originals[index] : duplicates[index];
+		};
+
+		Timer<double> frameTimer{};
+		Timer<double> updateTimer{};
+		double updateTotal{};
+		for (int frame = 0; frame < settings.frames; ++frame)
+		{
+			frameTimer.Reset();
+			bool placeholder{};
+			for (int i = 0; i < settings.texturesPerFrame; ++i)
+			{
+				const TextureHandle& handle = visible(frame, i);
+				handle.Get().Bind(GL_TEXTURE0);
+				placeholder = placeholder || !handle.Resident();
+			}
+
+			updateTimer.Reset();
+			manager.Update();
+			const double updateMs{ updateTimer.Elapsed() * 1000.0 };
+
+			updateTotal += updateMs;
+			result.maxUpdateMs = std::max(result.maxUpdateMs, updateMs);
+			result.placeholderFrames += placeholder ? 1 : 0;
+
+			// The rest of the frame
+			const double leftMs{ settings.frameMs - frameTimer.Elapsed() * 1000.0 };
+			if (leftMs > 0.0)
+				std::this_thread::sleep_for(std::chrono::duration<double, std::milli>{ leftMs });
+		}
+		glFinish();
+
+		manager.Flush();
+		for (int i = 0; i < settings.texturesPerFrame; ++i)
+		{
+			if (!visible(settings.frames - 1, i).Resident())
+				throw std::runtime_error("RunTextureCacheBench error: " + visible(settings.frames - 1, i).Key() + " was not loaded again");
+		}
+
+		result.frames = settings.frames;
+		result.updateMs = updateTotal / static_cast<double>(settings.frames);
+		result.stats = manager.Stats();
+
+		std::error_code error;
+		std::filesystem::remove_all(copyDirectory, error);
+		return result;
+	}
+
+	std::string FormatTextureCacheResult(const TextureCacheBenchResult& result)
+	{
+		const TextureCacheStats& stats = result.stats;
+		return std::format("Texture cache: {} frames, {} textures under two paths each, {:.1f} KiB when all resident\n"
+			"Update: {:.3f} ms mean, {:.3f} ms max, {} frames drew a placeholder\n"
+			"Cache: {} hits, {} misses, {} content hits, {} evictions, {} textures ({:.1f} KiB) resident at the end\n",
+			result.frames, result.textures, static_cast<double>(result.totalBytes) / 1024.0,
+			result.updateMs, result.maxUpdateMs, result.placeholderFrames,
+			stats.hits, stats.misses, stats.contentHits, stats.evictions, stats.residentTextures,
+			static_cast<double>(stats.residentBytes) / 1024.0);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "../GameEngine/TextureManager.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace GameEngine
+{
+	// A window of consecutive sprite textures is drawn every frame and slides over all of them,
+	// with a TextureManager budget below their summed size: the ones left behind are evicted
+	// and loaded again when the window comes back around
+	struct TextureCacheBenchSettings
+	{
+		int frames{ 600 };
+		int texturesPerFrame{ 4 };
+		int framesPerStep{ 4 };					// the window moves by one texture that often
+		double budgetRatio{ 0.35 };				// of the summed size of all the textures
+		std::uint64_t evictAfterFrames{ 8 };
+		double frameMs{ 4.0 };					// every frame lasts at least that long, the loaders need the time
+	};
+
+	struct TextureCacheBenchResult
+	{
+		int frames{};
+		int textures{};							// distinct images, each one under two paths
+		std::size_t totalBytes{};				// all of them resident
+		double updateMs{};						// TextureManager::Update() per frame
+		double maxUpdateMs{};
+		int placeholderFrames{};				// frames that drew a placeholder, a texture was reloading
+		TextureCacheStats stats{};
+	};
+
+	// Every sprite is loaded under its own path and under the path of a copy in a temporary directory,
+	// so the two share one texture by content and are evicted together. Checks at the end that the
+	// textures of the last frame came back. The GL context has to be current
+	// Exceptions: [runtime_error]
+	TextureCacheBenchResult RunTextureCacheBench(const TextureCacheBenchSettings& settings, const std::string& spritePath);
+
+	std::string FormatTextureCacheResult(const TextureCacheBenchResult& result);
+}
@@ -0,0 +1,283 @@
+#include "TileMapBench.hpp"
+#include "SpriteSweep.hpp"
+#include "../Timer.hpp"
+#include "../GameEngine/Camera2D.hpp"
+#include "../GameEngine/GpuProfiler.hpp"
+#include "../GameEngine/Renderer.hpp"
+#include "../GameEngine/Texture.hpp"
+#include "../GameEngine/TileArray.hpp"
+#include "../GameEngine/TileRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+namespace GameEngine
+{
+	// Tileset and bottom-left pixel of a TileArray layer in its image
+	struct TileSource
+	{
+		int tileset{};
+		int x{};
+		int y{};
+	};
+
+	static TileSource FindTile(const TileArray& tiles, const std::vector<Image>& images, int layer)
+	{
+		int tileset{ tiles.TilesetCount() - 1 };
+		while (tileset > 0 && tiles.FirstLayer(tileset) > layer)
+			--tileset;
+
+		const Image& image = images[static_cast<std::size_t>(tileset)];
+		const int frame{ layer - tiles.FirstLayer(tileset) };
+		const int columns{ image.width / tiles.TileWidth() };
+		return { tileset, frame % columns * tiles.TileWidth(), image.height - (frame / columns + 1) * tiles.TileHeight() };
+	}
+
+	// Draws 4x2 tiles spread over the whole array into the bottom-left corner of the output,
+	// one texel per pixel, and compares them to the tileset images
+	static void CheckTileRendering(TileRenderer& renderer, const TileArray& tiles, const std::vector<Image>& images)
+	{
+		constexpr int columns{ 4 };
+		constexpr int rows{ 2 };
+		const int width{ columns * tiles.TileWidth() };
+		const int height{ rows * tiles.TileHeight() };
+
+		std::vector<Tile> block;
+		for (int i = 0; i < columns * rows; ++i)
+		{
+			const int layer{ i * (tiles.LayerCount() - 1) / (columns * rows - 1) };
+			block.push_back({ static_cast<std::int16_t>(i % columns), static_cast<std::int16_t>(i / columns),
+				static_cast<std::uint16_t>(layer), static_cast<std::uint16_t>(i == 1 ? TileFlipX : 0) });
+		}
+
+		// Blending would darken the translucent texels
+		Renderer::SetDepthMode(Renderer::DepthMode::Painter2D);
+		glDisable(GL_BLEND);
+		Renderer::BindOutputFramebuffer();
+		glViewport(0, 0, width, height);
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		tiles.Bind(GL_TEXTURE0);
+		renderer.ResetStats();
+		renderer.AlphaCutoff(0.0f);
+		renderer.Draw(block, { { -1.0f, -1.0f }, { 2.0f / columns, 2.0f / rows }, 0.0f }, glm::mat4{ 1.0f }, glm::mat4{ 1.0f });
+
+		std::vector<unsigned char> pixels(static_cast<std::size_t>(width * height * 4));
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+		std::size_t differing{};
+		for (const Tile& tile : block)
+		{
+			const TileSource source{ FindTile(tiles, images, tile.layer) };
+			const Image& image = images[static_cast<std::size_t>(source.tileset)];
+			for (int y = 0; y < tiles.TileHeight(); ++y)
+			{
+				for (int x = 0; x < tiles.TileWidth(); ++x)
+				{
+					const int sourceX{ source.x + ((tile.flags & TileFlipX) != 0 ? tiles.TileWidth() - 1 - x : x) };
+					const unsigned char* expected = &image.pixels[static_cast<std::size_t>(((source.y + y) * image.width + sourceX) * 4)];
+					const unsigned char* drawn = &pixels[static_cast<std::size_t>(((tile.y * tiles.TileHeight() + y) * width + tile.x * tiles.TileWidth() + x) * 4)];
+					differing += std::equal(expected, expected + 4, drawn) ? 0 : 1;
+				}
+			}
+		}
+
+		glEnable(GL_BLEND);
+		if (differing != 0 || renderer.Stats().drawCalls != 1)
+		{
+			throw std::runtime_error(std::format("RunTileMapBench error: the 4x2 tile check drew {} differing pixels in {} draw calls",
+				differing, renderer.Stats().drawCalls));
+		}
+	}
+
+	// Drawing goes between the GPU scope, the stats are read after the last frame
+	static TileMapBenchResult MeasureMap(const TileMapBenchSettings& settings, const std::function<void()>& draw,
+		const std::function<void()>& resetStats, const std::function<SpriteRenderStats()>& stats)
+	{
+		GpuProfiler gpuProfiler{};
+		TileMapBenchResult result{};
+		Timer<double> stepTimer{};
+		Timer<double> frameTimer{};
+
+		for (int frame = -settings.warmupFrames; frame < settings.frames; ++frame)
+		{
+			if (frame == 0)
+			{
+				resetStats();
+				gpuProfiler.ResetStats();
+			}
+
+			gpuProfiler.BeginFrame();
+			frameTimer.Reset();
+
+			Renderer::BindOutputFramebuffer();
+			Renderer::Clear();
+
+			stepTimer.Reset();
+			gpuProfiler.BeginScope("tiles");
+			draw();
+			gpuProfiler.EndScope();
+			const double cpuTime{ stepTimer.Elapsed() };
+
+			gpuProfiler.EndFrame();
+			glFinish();
+			const double frameTime{ frameTimer.Elapsed() };
+
+			if (frame >= 0)
+			{
+				++result.frames;
+				result.cpuMs += cpuTime * 1000.0;
+				result.frameMs += frameTime * 1000.0;
+			}
+		}
+
+		// Collects the frames still in flight
+		gpuProfiler.BeginFrame();
+		gpuProfiler.EndFrame();
+
+		const double frames{ static_cast<double>(std::max(result.frames, 1)) };
+		result.cpuMs /= frames;
+		result.frameMs /= frames;
+		result.gpuMs = gpuProfiler.Passes().empty() ? 0.0 : gpuProfiler.Passes().front().MeanMs();
+		result.drawCalls = static_cast<double>(stats().drawCalls) / frames;
+		result.bytesUploaded = static_cast<double>(stats().bytesUploaded) / frames;
+		return result;
+	}
+
+	std::vector<TileMapBenchResult> RunTileMapBench(const TileMapBenchSettings& settings, int viewWidth, int viewHeight,
+		const std::string& shaderPath, const std::string& tilesetPath)
+	{
+		if (settings.tileSize <= 0 || settings.frames <= 0 || std::any_of(settings.columns.begin(), settings.columns.end(), [](int columns) { return columns <= 0; }))
+			throw std::runtime_error("RunTileMapBench error: tile size, frames and map widths have to be positive");
+
+		std::vector<Image> images;
+		for (const std::string& path : FindSpriteImages(tilesetPath))
+			images.push_back(LoadImage(path, 4));
+		if (images.empty())
+			throw std::runtime_error("RunTileMapBench error: no PNG tilesets in " + tilesetPath);
+
+		const TileArray tiles{ images, settings.tileSize, settings.tileSize };
+		if (tiles.LayerCount() < 8)
+			throw std::runtime_error("RunTileMapBench error: the tilesets in " + tilesetPath + " hold less than 8 tiles");
+
+		TileRenderer tileRenderer{ shaderPath };
+		CheckTileRendering(tileRenderer, tiles, images);
+
+		// The sprite path binds every tileset on its own
+		std::vector<Texture> textures;
+		textures.reserve(images.size());
+		for (const Image& image : images)
+			textures.emplace_back(image, GL_NEAREST);
+		std::unique_ptr<SpriteRenderer> spriteRenderer = CreateSpriteRenderer(settings.spriteBackend, shaderPath);
+
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		glViewport(0, 0, viewWidth, viewHeight);
+
+		const float aspectRatio{ static_cast<float>(viewWidth) / static_cast<float>(viewHeight) };
+		const Camera2D camera{ { 0.0f, 0.0f, 3.0f }, aspectRatio, 0.1f, 100.0f };
+		std::mt19937 generator{ 42 };
+
+		std::vector<TileMapBenchResult> results;
+		for (int columns : settings.columns)
+		{
+			const int rows{ std::max(1, static_cast<int>(std::lround(static_cast<float>(columns) / aspectRatio))) };
+			const TileGrid grid{ { -aspectRatio, -1.0f }, { 2.0f * aspectRatio / static_cast<float>(columns), 2.0f / static_cast<float>(rows) }, 0.0f };
+
+			// The same map both ways, sprites grouped by tileset
+			std::uniform_int_distribution<int> layerDist{ 0, tiles.LayerCount() - 1 };
+			std::uniform_int_distribution<int> flagDist{ 0, 3 };
+			std::vector<Tile> map;
+			std::vector<std::vector<Sprite>> sprites(images.size());
+			for (int y = 0; y < rows; ++y)
+			{
+				for (int x = 0; x < columns; ++x)
+				{
+					const Tile tile{ static_cast<std::int16_t>(x), static_cast<std::int16_t>(y),
+						static_cast<std::uint16_t>(layerDist(generator)), static_cast<std::uint16_t>(flagDist(generator)) };
+					map.push_back(tile);
+
+					const TileSource source{ FindTile(tiles, images, tile.layer) };
+					const Image& image = images[static_cast<std::size_t>(source.tileset)];
+					glm::vec4 uvRect{
+						static_cast<float>(source.x) / static_cast<float>(image.width),
+						static_cast<float>(source.y) / static_cast<float>(image.height),
+						static_cast<float>(source.x + tiles.TileWidth()) / static_cast<float>(image.width),
+						static_cast<float>(source.y + tiles.TileHeight()) / static_cast<float>(image.height) };
+					if ((tile.flags & TileFlipX) != 0)
+						std::swap(uvRect.x, uvRect.z);
+					if ((tile.flags & TileFlipY) != 0)
+						std::swap(uvRect.y, uvRect.w);
+
+					Sprite sprite{};
+					const glm::vec2 center{ grid.origin + (glm::vec2{ static_cast<float>(x), static_cast<float>(y) } + glm::vec2{ 0.5f }) * grid.cellSize };
+					sprite.position = glm::vec3{ center, 0.0f };
+					sprite.size = grid.cellSize;
+					sprite.uvRect = uvRect;
+					sprites[static_cast<std::size_t>(source.tileset)].push_back(sprite);
+				}
+			}
+
+			Renderer::SetDepthMode(Renderer::DepthMode::Painter2D);
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+			TileMapBenchResult tileResult{ MeasureMap(settings,
+				[&]()
+				{
+					tiles.Bind(GL_TEXTURE0);
+					tileRenderer.Draw(map, grid, camera.View(), camera.Projection());
+				},
+				[&]() { tileRenderer.ResetStats(); },
+				[&]() { return tileRenderer.Stats(); }) };
+			tileResult.path = "tiles";
+
+			TileMapBenchResult spriteResult{ MeasureMap(settings,
+				[&]()
+				{
+					for (std::size_t tileset = 0; tileset < textures.size(); ++tileset)
+					{
+						textures[tileset].Bind(GL_TEXTURE0);
+						spriteRenderer->Draw(sprites[tileset], camera.View(), camera.Projection());
+					}
+				},
+				[&]() { spriteRenderer->ResetStats(); },
+				[&]() { return spriteRenderer->Stats(); }) };
+			spriteResult.path = std::string{ "sprites/" } + ToString(settings.spriteBackend);
+
+			for (TileMapBenchResult* result : { &tileResult, &spriteResult })
+			{
+				result->columns = columns;
+				result->rows = rows;
+				result->tilesets = tiles.TilesetCount();
+				results.push_back(std::move(*result));
+				std::cout << (results.size() == 1 ? FormatTileMapTable(results) : FormatTileMapRow(results.back())) << std::flush;
+			}
+		}
+
+		return results;
+	}
+
+	std::string FormatTileMapTable(const std::vector<TileMapBenchResult>& results)
+	{
+		std::string table{ std::format("{:>8}{:>6}{:>9}{:>10}  {:<18}{:>8}{:>10}{:>10}{:>10}{:>8}{:>12}\n",
+			"columns", "rows", "tiles", "tilesets", "path", "frames", "cpu ms", "gpu ms", "frame ms", "draws", "KiB/frame") };
+
+		for (const TileMapBenchResult& result : results)
+			table += FormatTileMapRow(result);
+
+		return table;
+	}
+
+	std::string FormatTileMapRow(const TileMapBenchResult& result)
+	{
+		return std::format("{:>8}{:>6}{:>9}{:>10}  {:<18}{:>8}{:>10.3f}{:>10.3f}{:>10.3f}{:>8.0f}{:>12.1f}\n",
+			result.columns, result.rows, result.columns * result.rows, result.tilesets, result.path, result.frames,
+			result.cpuMs, result.gpuMs, result.frameMs, result.drawCalls, result.bytesUploaded / 1024.0);
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "../GameEngine/SpriteRenderer.hpp"
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// A screen-filling map of random tiles from every tileset, drawn by the TileRenderer in one
+	// instanced draw, then as sprites with one draw per tileset texture for comparison
+	struct TileMapBenchSettings
+	{
+		std::vector<int> columns{ 80, 160, 320 };		// map width in tiles, the rows follow the view aspect
+		int tileSize{ 16 };								// in tileset pixels
+		SpriteBackend spriteBackend{ SpriteBackend::Batched };
+		int warmupFrames{ 5 };
+		int frames{ 60 };
+	};
+
+	// Per frame averages of one way of drawing one map
+	struct TileMapBenchResult
+	{
+		int columns{};
+		int rows{};
+		int tilesets{};
+		std::string path;		// "tiles", or the sprite backend
+		int frames{};
+		double cpuMs{};			// draw calls, including the uploads
+		double gpuMs{};
+		double frameMs{};		// everything up to glFinish
+		double drawCalls{};
+		double bytesUploaded{};
+	};
+
+	// Checks first that a 4x2 block of tiles from several tilesets, one of them flipped, is drawn pixel exact
+	// in a single call, then measures both paths for every map width. The GL context has to be current.
+	// Tilesets are taken from the PNG files under tilesetPath
+	// Exceptions: [runtime_error]
+	std::vector<TileMapBenchResult> RunTileMapBench(const TileMapBenchSettings& settings, int viewWidth, int viewHeight,
+		const std::string& shaderPath, const std::string& tilesetPath);
+
+	// Header line and one line per result
+	std::string FormatTileMapTable(const std::vector<TileMapBenchResult>& results);
+	std::string FormatTileMapRow(const TileMapBenchResult& result);
+}
@@ -0,0 +1,129 @@
+#include "AssetCooker.hpp"
+#include "../GameEngine/AssetPack.hpp"
+#include "../GameEngine/Image.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace GameEngine
+{
+	namespace fs = std::filesystem;
+
+	static std::vector<unsigned char> ReadFile(const fs::path& path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		if (!file)
+			throw std::runtime_error("CookAssets error: can't open " + path.string());
+
+		return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	}
+
+	static void WriteFile(const fs::path& path, const std::vector<unsigned char>& bytes)
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		if (!file)
+			throw std::runtime_error("CookAssets error: can't write " + path.string());
+	}
+
+	static bool IsImage(const fs::path& path)
+	{
+		std::string extension{ path.extension().string() };
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+		return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".tga";
+	}
+
+	// Grey images are widened to RGB(A), the texture formats start at 3 channels
+	static Image DecodeForCooking(const std::vector<unsigned char>& bytes, const std::string& name)
+	{
+		Image image{ DecodeImage(bytes, 0, name) };
+		if (image.channels < 3)
+			image = DecodeImage(bytes, image.channels == 2 ? 4 : 3, name);
+
+		return image;
+	}
+
+	CookerReport CookAssets(const CookerSettings& settings)
+	{
+		CookerReport report{};
+		fs::create_directories(settings.cacheDirectory);
+
+		// A cached blob is valid for the same source bytes, cook settings and blob version
+		const unsigned char settingsKey[]{ static_cast<unsigned char>(CookedTextureHeader::currentVersion),
+			static_cast<unsigned char>(settings.texture.premultiplyAlpha), static_cast<unsigned char>(settings.texture.mipmaps),
+			static_cast<unsigned char>(settings.texture.blockCompression), static_cast<unsigned char>(settings.texture.blockCompressionMinExtent),
+			static_cast<unsigned char>(settings.texture.blockCompressionMinExtent >> 8) };
+		const AssetCompression textureCompression{ settings.compress ? AssetCompression::Lz4 : AssetCompression::None };
+
+		std::vector<fs::path> files;
+		for (const std::string& directory : settings.inputDirectories)
+		{
+			if (!fs::is_directory(directory))
+				throw std::runtime_error("CookAssets error: no directory " + directory);
+
+			for (const auto& entry : fs::recursive_directory_iterator{ directory })
+			{
+				if (entry.is_regular_file())
+					files.push_back(entry.path());
+			}
+		}
+		std::sort(files.begin(), files.end());
+
+		AssetPackWriter writer{};
+		// The pack also depends on its format and the compression
+		const unsigned char packKey[]{ static_cast<unsigned char>(AssetPackHeader::currentVersion), static_cast<unsigned char>(settings.compress) };
+		std::uint64_t packHash{ HashAssetData(packKey, HashAssetData(settingsKey)) };
+		for (const fs::path& file : files)
+		{
+			const std::string name{ file.generic_string() };
+			std::vector<unsigned char> bytes{ ReadFile(file) };
+			const std::uint64_t sourceHash{ HashAssetData(bytes) };
+
+			packHash = HashAssetData({ reinterpret_cast<const unsigned char*>(name.data()), name.size() }, packHash);
+			packHash = HashAssetData({ reinterpret_cast<const unsigned char*>(&sourceHash), sizeof(sourceHash) }, packHash);
+
+			if (!IsImage(file))
+			{
+				writer.Add(name, std::move(bytes));
+				++report.copied;
+				continue;
+			}
+
+			const fs::path cachePath{ fs::path{ settings.cacheDirectory } / std::format("{:016x}.ctex", HashAssetData(settingsKey, sourceHash)) };
+			if (fs::exists(cachePath))
+			{
+				writer.Add(CookedTextureName(name), ReadFile(cachePath), textureCompression);
+				++report.reused;
+				continue;
+			}
+
+			std::vector<unsigned char> cooked{ CookTexture(DecodeForCooking(bytes, name), settings.texture) };
+			WriteFile(cachePath, cooked);
+			writer.Add(CookedTextureName(name), std::move(cooked), textureCompression);
+			++report.cooked;
+		}
+
+		// The same sources with the same settings give the same pack, it is not written again
+		const fs::path packHashPath{ fs::path{ settings.cacheDirectory } / (fs::path{ settings.outputPath }.filename().string() + ".hash") };
+		const std::string packHashText{ std::format("{:016x}", packHash) };
+		if (fs::exists(settings.outputPath) && fs::exists(packHashPath))
+		{
+			std::ifstream hashFile{ packHashPath };
+			std::string previousHash;
+			hashFile >> previousHash;
+			if (previousHash == packHashText)
+				return report;
+		}
+
+		writer.Write(settings.outputPath);
+		std::ofstream{ packHashPath } << packHashText << '\n';
+		report.packWritten = true;
+
+		return report;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "../GameEngine/CookedTexture.hpp"
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	struct CookerSettings
+	{
+		std::vector<std::string> inputDirectories{ "resources/", "src/shaders/" };
+		std::string outputPath{ "assets.pak" };
+
+		// Cooked blobs named by the hash of their source and settings, and the hash of the last written pack
+		std::string cacheDirectory{ "cooked" };
+
+		CookSettings texture{};
+
+		// Cooked textures are stored LZ4 compressed (see AssetCompression)
+		bool compress{ true };
+	};
+
+	struct CookerReport
+	{
+		int cooked{};			// images decoded and cooked in this run
+		int reused{};			// images whose source did not change, taken from the cache
+		int copied{};			// other files, packed as they are
+		bool packWritten{};		// false when nothing changed since the last run
+	};
+
+	// Images (png, jpg, jpeg, bmp, tga) become cooked textures named by CookedTextureName,
+	// everything else is packed unchanged
+	// Exceptions: [runtime_error]
+	CookerReport CookAssets(const CookerSettings& settings);
+}
@@ -0,0 +1,64 @@
+#include "AssetCooker.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Offline asset cooker: decodes, flips, premultiplies, mipmaps and block compresses the images once,
+// so the game uploads them from the pack without decoding. Options:
+// --output path               pack to write, assets.pak by default
+// --cache directory           cooked blobs of unchanged sources are reused from there, cooked/ by default
+// --premultiply               premultiplies the alpha, straight alpha by default
+// --no-mipmaps                cooks only the base level
+// --no-compression            stores the cooked textures without LZ4
+// --no-block-compression      keeps the photographic textures as RGB8/RGBA8 instead of BC1/BC3
+// --block-min-extent pixels   smaller textures are not block compressed, 256 by default
+// other arguments             input directories, resources/ and src/shaders/ by default
+int main(int argc, char* argv[])
+{
+	try
+	{
+		GameEngine::CookerSettings settings{};
+		std::vector<std::string> inputs;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option{ argv[i] };
+			const bool hasValue{ i + 1 < argc };
+
+			if (option == "--output" && hasValue)
+				settings.outputPath = argv[++i];
+			else if (option == "--cache" && hasValue)
+				settings.cacheDirectory = argv[++i];
+			else if (option == "--premultiply")
+				settings.texture.premultiplyAlpha = true;
+			else if (option == "--no-mipmaps")
+				settings.texture.mipmaps = false;
+			else if (option == "--no-compression")
+				settings.compress = false;
+			else if (option == "--no-block-compression")
+				settings.texture.blockCompression = false;
+			else if (option == "--block-min-extent" && hasValue)
+				settings.texture.blockCompressionMinExtent = std::stoi(argv[++i]);
+			else if (option.rfind("--", 0) == 0)
+				throw std::runtime_error("Unknown option or missing value: " + option);
+			else
+				inputs.push_back(option);
+		}
+
+		if (!inputs.empty())
+			settings.inputDirectories = inputs;
+
+		const GameEngine::CookerReport report = GameEngine::CookAssets(settings);
+		std::cout << report.cooked << " textures cooked, " << report.reused << " unchanged, " << report.copied << " files copied\n";
+		std::cout << (report.packWritten ? "Written " : "Up to date ") << settings.outputPath << '\n';
+	}
+
+	catch (const std::exception& except)
+	{
+		std::cout << "Cooking failed:\n" << except.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,41 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace GameEngine;
+
+static std::atomic<std::uint64_t> allocationCount{};
+static std::atomic<std::uint64_t> allocationBytes{};
+
+AllocationTotals GameEngine::CurrentAllocations() noexcept
+{
+	return { allocationCount.load(std::memory_order_relaxed), allocationBytes.load(std::memory_order_relaxed) };
+}
+
+#ifndef GAMEENGINE_PROFILER_DISABLED
+
+// The array and nothrow forms forward to these by default, the aligned ones are left alone
+void* operator new(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size > 0 ? size : 1))
+		return memory;
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace GameEngine
+{
+	struct AllocationTotals
+	{
+		std::uint64_t count{};
+		std::uint64_t bytes{};
+	};
+
+	// Totals of the global operator new calls since the start of the program. Counting
+	// replaces operator new/delete (AllocationCounter.cpp) and is compiled out with the
+	// profiler (GAMEENGINE_PROFILER_DISABLED), the totals stay zero then
+	AllocationTotals CurrentAllocations() noexcept;
+}
@@ -0,0 +1,28 @@
+#include "AlphaClass.hpp"
+
+using namespace GameEngine;
+
+AlphaClass GameEngine::ClassifyAlpha(const unsigned char* pixels, int imageWidth, int channels, int x, int y, int width, int height) noexcept
+{
+	if (channels != 4)
+		return AlphaClass::Opaque;
+
+	AlphaClass result{ AlphaClass::Opaque };
+	for (int row = y; row < y + height; ++row)
+	{
+		const unsigned char* pixel = pixels + (static_cast<std::size_t>(row) * imageWidth + x) * 4;
+		for (int column = 0; column < width; ++column, pixel += 4)
+		{
+			const unsigned char alpha{ pixel[3] };
+			if (alpha == 255)
+				continue;
+
+			if (alpha != 0)
+				return AlphaClass::Translucent;
+
+			result = AlphaClass::Cutout;
+		}
+	}
+
+	return result;
+}
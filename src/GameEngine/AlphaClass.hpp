@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace GameEngine
+{
+	// How a sprite has to be drawn depending on its alpha channel
+	enum class AlphaClass : std::uint8_t
+	{
+		Opaque,			// alpha is 255 everywhere
+		Cutout,			// alpha is either 0 or 255, an alpha test is enough
+		Translucent,	// partial alpha, needs blending in back-to-front order
+	};
+
+	// Classifies the region [x; x + width) x [y; y + height) of an image
+	// with the given row length and channel count (only 4 channels carry alpha)
+	AlphaClass ClassifyAlpha(const unsigned char* pixels, int imageWidth, int channels, int x, int y, int width, int height) noexcept;
+}
@@ -0,0 +1,382 @@
+#include "AssetPack.hpp"
+#include "CpuProfiler.hpp"
+#include "JobSystem.hpp"
+#include "Lz4.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+static_assert(std::endian::native == std::endian::little, "AssetPack: the pack layout is little endian");
+
+static constexpr std::uint64_t dataAlignment{ 16 };
+
+static std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment) noexcept
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+static std::uint32_t BucketOf(std::uint64_t hash, std::uint32_t bucketBits) noexcept
+{
+	return bucketBits == 0 ? 0 : static_cast<std::uint32_t>(hash >> (64 - bucketBits));
+}
+
+// About one entry per bucket
+static std::uint32_t BucketBitsFor(std::size_t entryCount) noexcept
+{
+	return entryCount <= 1 ? 0 : static_cast<std::uint32_t>(std::bit_width(entryCount - 1));
+}
+
+
+//						[CONSTRUCTORS]
+
+AssetPack::AssetPack(const std::string& path)
+	: m_File{ path }
+{
+	PROFILE_ZONE("Asset pack open");
+
+	const std::span<const unsigned char> bytes{ m_File.Bytes() };
+	AssetPackHeader header{};
+	if (bytes.size() < sizeof(header))
+		throw std::runtime_error("AssetPack.AssetPack error: not an asset pack " + path);
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, AssetPackHeader{}.magic, sizeof(header.magic)) != 0)
+		throw std::runtime_error("AssetPack.AssetPack error: not an asset pack " + path);
+	if (header.version != AssetPackHeader::currentVersion)
+		throw std::runtime_error("AssetPack.AssetPack error: unsupported version of " + path);
+	if (header.bucketBits > 31)
+		throw std::runtime_error("AssetPack.AssetPack error: corrupted table of contents in " + path);
+
+	const std::uint64_t entriesEnd{ sizeof(header) + std::uint64_t{ header.entryCount } * sizeof(AssetPackEntry) };
+	const std::uint64_t bucketCount{ (std::uint64_t{ 1 } << header.bucketBits) + 1 };
+	const std::uint64_t bucketsEnd{ entriesEnd + bucketCount * sizeof(std::uint32_t) };
+	if (bucketsEnd > bytes.size() || header.namesOffset < bucketsEnd || header.namesOffset > bytes.size()
+		|| header.namesSize > bytes.size() - header.namesOffset)
+		throw std::runtime_error("AssetPack.AssetPack error: corrupted table of contents in " + path);
+
+	// The mapping is page aligned and every block is a multiple of 8 bytes in
+	m_Entries = { reinterpret_cast<const AssetPackEntry*>(bytes.data() + sizeof(header)), header.entryCount };
+	m_Buckets = { reinterpret_cast<const std::uint32_t*>(bytes.data() + entriesEnd), static_cast<std::size_t>(bucketCount) };
+	m_Names = { reinterpret_cast<const char*>(bytes.data() + header.namesOffset), static_cast<std::size_t>(header.namesSize) };
+	m_BucketBits = header.bucketBits;
+
+	for (const AssetPackEntry& entry : m_Entries)
+	{
+		if (entry.offset > bytes.size() || entry.storedSize > bytes.size() - entry.offset
+			|| std::uint64_t{ entry.nameOffset } + entry.nameSize > m_Names.size())
+			throw std::runtime_error("AssetPack.AssetPack error: entry outside the file in " + path);
+		if (entry.compression == AssetCompression::None ? entry.storedSize != entry.size : entry.compression != AssetCompression::Lz4)
+			throw std::runtime_error("AssetPack.AssetPack error: unknown compression in " + path);
+	}
+
+	if (m_Buckets.back() != header.entryCount || !std::is_sorted(m_Buckets.begin(), m_Buckets.end()))
+		throw std::runtime_error("AssetPack.AssetPack error: corrupted bucket index in " + path);
+}
+
+
+//						[GETTERS]
+
+std::string_view AssetPack::Name(const AssetPackEntry& entry) const noexcept
+{
+	return m_Names.substr(entry.nameOffset, entry.nameSize);
+}
+
+const AssetPackEntry* AssetPack::Find(std::string_view name) const noexcept
+{
+	const std::uint64_t hash{ HashAssetName(name) };
+	const std::uint32_t bucket{ BucketOf(hash, m_BucketBits) };
+
+	for (std::uint32_t i = m_Buckets[bucket]; i < m_Buckets[bucket + 1]; ++i)
+	{
+		const AssetPackEntry& entry = m_Entries[i];
+		if (entry.hash == hash && Name(entry) == name)
+			return &entry;
+	}
+
+	return nullptr;
+}
+
+std::span<const unsigned char> AssetPack::Data(std::string_view name) const
+{
+	const AssetPackEntry* entry{ Find(name) };
+	if (entry == nullptr)
+		throw std::runtime_error("AssetPack.Data error: no asset " + std::string{ name });
+	if (entry->compression != AssetCompression::None)
+		throw std::runtime_error("AssetPack.Data error: compressed asset " + std::string{ name } + ", it has to be read");
+
+	return m_File.Bytes().subspan(static_cast<std::size_t>(entry->offset), static_cast<std::size_t>(entry->size));
+}
+
+std::string_view AssetPack::Text(std::string_view name) const
+{
+	const std::span<const unsigned char> data{ Data(name) };
+	return { reinterpret_cast<const char*>(data.data()), data.size() };
+}
+
+
+//						[UTILITY]
+
+void AssetPack::Read(const AssetPackEntry& entry, std::span<unsigned char> destination, JobSystem* jobs) const
+{
+	PROFILE_ZONE("Asset read");
+
+	if (destination.size() < entry.size)
+		throw std::runtime_error("AssetPack.Read error: the destination is too small for " + std::string{ Name(entry) });
+
+	const std::span<const unsigned char> stored{ m_File.Bytes().subspan(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.storedSize)) };
+	if (entry.compression == AssetCompression::None)
+	{
+		std::copy(stored.begin(), stored.end(), destination.begin());
+		return;
+	}
+
+	const std::size_t blockCount{ static_cast<std::size_t>((entry.size + assetPackBlockSize - 1) / assetPackBlockSize) };
+	if (stored.size() < blockCount * sizeof(std::uint32_t))
+		throw std::runtime_error("AssetPack.Read error: corrupted block table of " + std::string{ Name(entry) });
+
+	// Where every block starts in the file, the sizes alone do not tell it
+	std::vector<std::span<const unsigned char>> blocks(blockCount);
+	std::size_t offset{ blockCount * sizeof(std::uint32_t) };
+	for (std::size_t i = 0; i < blockCount; ++i)
+	{
+		std::uint32_t blockSize;
+		std::memcpy(&blockSize, stored.data() + i * sizeof(blockSize), sizeof(blockSize));
+
+		const std::size_t size{ blockSize & ~storedBlockFlag };
+		if (size > stored.size() - offset)
+			throw std::runtime_error("AssetPack.Read error: corrupted block table of " + std::string{ Name(entry) });
+
+		blocks[i] = stored.subspan(offset, size);
+		offset += size;
+	}
+
+	auto decompress = [&entry, &blocks, &stored, destination](std::size_t begin, std::size_t end, std::size_t)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const std::size_t blockBegin{ i * assetPackBlockSize };
+			const std::size_t blockSize{ std::min(assetPackBlockSize, static_cast<std::size_t>(entry.size) - blockBegin) };
+			const std::span<unsigned char> target{ destination.subspan(blockBegin, blockSize) };
+
+			std::uint32_t storedSize;
+			std::memcpy(&storedSize, stored.data() + i * sizeof(storedSize), sizeof(storedSize));
+
+			const bool raw{ (storedSize & storedBlockFlag) != 0 };
+			if (raw ? blocks[i].size() != blockSize : Lz4Decompress(blocks[i], target) != blockSize)
+				throw std::runtime_error("AssetPack.Read error: corrupted block");
+			if (raw)
+				std::copy(blocks[i].begin(), blocks[i].end(), target.begin());
+		}
+	};
+
+	if (jobs != nullptr && blockCount > 1)
+		jobs->ParallelFor(blockCount, jobs->WorkerCount() + 1, decompress);
+	else
+		decompress(0, blockCount, 0);
+}
+
+std::vector<unsigned char> AssetPack::Read(std::string_view name, JobSystem* jobs) const
+{
+	const AssetPackEntry* entry{ Find(name) };
+	if (entry == nullptr)
+		throw std::runtime_error("AssetPack.Read error: no asset " + std::string{ name });
+
+	std::vector<unsigned char> bytes(static_cast<std::size_t>(entry->size));
+	Read(*entry, bytes, jobs);
+	return bytes;
+}
+
+std::span<unsigned char> AssetPack::ReadPrefix(const AssetPackEntry& entry, std::span<unsigned char> destination) const
+{
+	const std::size_t size{ std::min(destination.size(), static_cast<std::size_t>(entry.size)) };
+	const std::span<const unsigned char> stored{ m_File.Bytes().subspan(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.storedSize)) };
+	if (entry.compression == AssetCompression::None)
+	{
+		std::copy_n(stored.begin(), size, destination.begin());
+		return destination.first(size);
+	}
+
+	if (size == 0)
+		return destination.first(0);
+
+	// The first block starts right after the block table
+	const std::size_t blockCount{ static_cast<std::size_t>((entry.size + assetPackBlockSize - 1) / assetPackBlockSize) };
+	std::uint32_t storedSize;
+	if (stored.size() < blockCount * sizeof(storedSize))
+		throw std::runtime_error("AssetPack.ReadPrefix error: corrupted block table of " + std::string{ Name(entry) });
+	std::memcpy(&storedSize, stored.data(), sizeof(storedSize));
+
+	const std::size_t blockSize{ std::min(assetPackBlockSize, static_cast<std::size_t>(entry.size)) };
+	const std::size_t offset{ blockCount * sizeof(storedSize) };
+	if ((storedSize & ~storedBlockFlag) > stored.size() - offset)
+		throw std::runtime_error("AssetPack.ReadPrefix error: corrupted block table of " + std::string{ Name(entry) });
+	const std::span<const unsigned char> block{ stored.subspan(offset, storedSize & ~storedBlockFlag) };
+
+	if ((storedSize & storedBlockFlag) != 0)
+	{
+		if (block.size() != blockSize)
+			throw std::runtime_error("AssetPack.ReadPrefix error: corrupted block");
+		std::copy_n(block.begin(), size, destination.begin());
+		return destination.first(size);
+	}
+
+	std::vector<unsigned char> decompressed(blockSize);
+	if (Lz4Decompress(block, decompressed) != blockSize)
+		throw std::runtime_error("AssetPack.ReadPrefix error: corrupted block");
+
+	std::copy_n(decompressed.begin(), size, destination.begin());
+	return destination.first(size);
+}
+
+// Block table followed by the blocks, empty when the whole asset would not get smaller
+static std::vector<unsigned char> CompressBlocks(std::span<const unsigned char> bytes)
+{
+	const std::size_t blockCount{ (bytes.size() + assetPackBlockSize - 1) / assetPackBlockSize };
+	std::vector<unsigned char> compressed(blockCount * sizeof(std::uint32_t));
+	std::vector<unsigned char> block(Lz4CompressBound(assetPackBlockSize));
+
+	for (std::size_t i = 0; i < blockCount; ++i)
+	{
+		const std::span<const unsigned char> source{ bytes.subspan(i * assetPackBlockSize, std::min(assetPackBlockSize, bytes.size() - i * assetPackBlockSize)) };
+		std::size_t size{ Lz4Compress(source, block) };
+
+		std::uint32_t blockSize{ static_cast<std::uint32_t>(size) };
+		if (size == 0 || size >= source.size())
+		{
+			blockSize = static_cast<std::uint32_t>(source.size()) | storedBlockFlag;
+			compressed.insert(compressed.end(), source.begin(), source.end());
+		}
+		else
+			compressed.insert(compressed.end(), block.begin(), block.begin() + static_cast<std::ptrdiff_t>(size));
+
+		std::memcpy(compressed.data() + i * sizeof(blockSize), &blockSize, sizeof(blockSize));
+	}
+
+	if (compressed.size() >= bytes.size())
+		compressed.clear();
+	return compressed;
+}
+
+void AssetPackWriter::Add(std::string name, std::vector<unsigned char> bytes, AssetCompression compression)
+{
+	std::replace(name.begin(), name.end(), '\\', '/');
+
+	const bool duplicate = std::any_of(m_Assets.begin(), m_Assets.end(), [&name](const PendingAsset& asset) { return asset.name == name; });
+	if (duplicate)
+		throw std::runtime_error("AssetPackWriter.Add error: duplicate asset " + name);
+
+	const std::uint64_t size{ bytes.size() };
+	if (compression == AssetCompression::Lz4)
+	{
+		std::vector<unsigned char> compressed{ CompressBlocks(bytes) };
+		if (compressed.empty())
+			compression = AssetCompression::None;
+		else
+			bytes = std::move(compressed);
+	}
+
+	m_Assets.push_back({ std::move(name), std::move(bytes), size, compression });
+}
+
+void AssetPackWriter::AddFile(const std::string& path, std::string name)
+{
+	std::ifstream file{ path, std::ios::binary };
+	if (!file)
+		throw std::runtime_error("AssetPackWriter.AddFile error: can't open " + path);
+
+	std::vector<unsigned char> bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	Add(name.empty() ? path : std::move(name), std::move(bytes));
+}
+
+void AssetPackWriter::AddDirectory(const std::string& directory)
+{
+	if (!std::filesystem::is_directory(directory))
+		throw std::runtime_error("AssetPackWriter.AddDirectory error: no directory " + directory);
+
+	std::vector<std::filesystem::path> files;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator{ directory })
+	{
+		if (entry.is_regular_file())
+			files.push_back(entry.path());
+	}
+
+	// Same pack for the same files whatever order the file system lists them in
+	std::sort(files.begin(), files.end());
+	for (const std::filesystem::path& file : files)
+		AddFile(file.string(), file.generic_string());
+}
+
+void AssetPackWriter::Write(const std::string& path) const
+{
+	std::vector<const PendingAsset*> sorted;
+	sorted.reserve(m_Assets.size());
+	for (const PendingAsset& asset : m_Assets)
+		sorted.push_back(&asset);
+
+	std::sort(sorted.begin(), sorted.end(), [](const PendingAsset* a, const PendingAsset* b)
+	{
+		const std::uint64_t hashA{ HashAssetName(a->name) };
+		const std::uint64_t hashB{ HashAssetName(b->name) };
+		return hashA != hashB ? hashA < hashB : a->name < b->name;
+	});
+
+	AssetPackHeader header{};
+	header.entryCount = static_cast<std::uint32_t>(sorted.size());
+	header.bucketBits = BucketBitsFor(sorted.size());
+
+	std::vector<AssetPackEntry> entries(sorted.size());
+	std::vector<std::uint32_t> buckets((std::size_t{ 1 } << header.bucketBits) + 1);
+	std::string names;
+	for (std::size_t i = 0; i < sorted.size(); ++i)
+	{
+		entries[i].hash = HashAssetName(sorted[i]->name);
+		entries[i].size = sorted[i]->size;
+		entries[i].storedSize = sorted[i]->bytes.size();
+		entries[i].compression = sorted[i]->compression;
+		entries[i].nameOffset = static_cast<std::uint32_t>(names.size());
+		entries[i].nameSize = static_cast<std::uint32_t>(sorted[i]->name.size());
+		names += sorted[i]->name;
+
+		// Counted here, turned into starts below
+		++buckets[BucketOf(entries[i].hash, header.bucketBits) + 1];
+	}
+	for (std::size_t bucket = 1; bucket < buckets.size(); ++bucket)
+		buckets[bucket] += buckets[bucket - 1];
+
+	header.namesOffset = sizeof(header) + entries.size() * sizeof(AssetPackEntry) + buckets.size() * sizeof(std::uint32_t);
+	header.namesSize = names.size();
+
+	std::uint64_t offset{ AlignUp(header.namesOffset + header.namesSize, dataAlignment) };
+	for (std::size_t i = 0; i < sorted.size(); ++i)
+	{
+		entries[i].offset = offset;
+		offset = AlignUp(offset + entries[i].storedSize, dataAlignment);
+	}
+
+	std::ofstream file{ path, std::ios::binary };
+	if (!file)
+		throw std::runtime_error("AssetPackWriter.Write error: can't open " + path);
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetPackEntry)));
+	file.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(std::uint32_t)));
+	file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+	const char padding[dataAlignment]{};
+	std::uint64_t written{ header.namesOffset + header.namesSize };
+	for (std::size_t i = 0; i < sorted.size(); ++i)
+	{
+		file.write(padding, static_cast<std::streamsize>(entries[i].offset - written));
+		file.write(reinterpret_cast<const char*>(sorted[i]->bytes.data()), static_cast<std::streamsize>(sorted[i]->bytes.size()));
+		written = entries[i].offset + entries[i].storedSize;
+	}
+
+	if (!file)
+		throw std::runtime_error("AssetPackWriter.Write error: failed to write " + path);
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace GameEngine
+{
+	class JobSystem;
+
+	// FNV-1a of the asset name, names use forward slashes ("resources/container.jpg")
+	constexpr std::uint64_t HashAssetName(std::string_view name) noexcept
+	{
+		std::uint64_t hash{ 14695981039346656037ull };
+		for (char c : name)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	// FNV-1a of asset contents, the cooker keys its cache with it. Chains through the hash argument
+	inline std::uint64_t HashAssetData(std::span<const unsigned char> bytes, std::uint64_t hash = 14695981039346656037ull) noexcept
+	{
+		for (unsigned char byte : bytes)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	enum class AssetCompression : std::uint32_t
+	{
+		None,
+		Lz4,		// independent blocks of assetPackBlockSize bytes, see Lz4.hpp
+	};
+
+	// Compressed assets start with the compressed size of every block, the top bit marks a block stored as it is.
+	// Blocks are independent, so they decompress in parallel
+	inline constexpr std::size_t assetPackBlockSize{ 64 * 1024 };
+	inline constexpr std::uint32_t storedBlockFlag{ 0x80000000u };
+
+	// Pack file layout, little endian:
+	// header | entries sorted by hash | bucket starts | names | data, every asset 16-byte aligned
+	struct AssetPackHeader
+	{
+		static constexpr std::uint32_t currentVersion{ 2 };
+
+		char			magic[4]{ 'A', 'P', 'A', 'K' };
+		std::uint32_t	version{ currentVersion };
+		std::uint32_t	entryCount{};
+		std::uint32_t	bucketBits{};		// the top bits of the hash select one of 2^bucketBits buckets
+		std::uint64_t	namesOffset{};
+		std::uint64_t	namesSize{};
+	};
+
+	struct AssetPackEntry
+	{
+		std::uint64_t	hash{};
+		std::uint64_t	offset{};			// from the start of the file
+		std::uint64_t	size{};				// of the asset itself
+		std::uint64_t	storedSize{};		// in the file, smaller than size when compressed
+		std::uint32_t	nameOffset{};		// into the names block
+		std::uint32_t	nameSize{};
+		AssetCompression compression{};
+		std::uint32_t	reserved{};
+	};
+
+	static_assert(sizeof(AssetPackHeader) == 32 && std::is_trivially_copyable_v<AssetPackHeader>);
+	static_assert(sizeof(AssetPackEntry) == 48 && std::is_trivially_copyable_v<AssetPackEntry>);
+
+	// Read-only archive of assets in one memory-mapped file. The table of contents is
+	// sorted by name hash with a bucket index on top, so a lookup touches about one entry.
+	// Uncompressed data comes straight from the mapping, the spans stay valid as long as the pack
+	class AssetPack
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Checks the header and that every entry lies inside the file
+		// Exceptions: [runtime_error]
+		explicit AssetPack(const std::string& path);
+
+
+		//				[GETTERS]
+
+		std::span<const AssetPackEntry> Entries() const noexcept { return m_Entries; }
+		std::string_view Name(const AssetPackEntry& entry) const noexcept;
+
+		// nullptr when the pack has no such asset
+		const AssetPackEntry* Find(std::string_view name) const noexcept;
+		bool Contains(std::string_view name) const noexcept { return Find(name) != nullptr; }
+
+		// Uncompressed assets only
+		// Exceptions: [runtime_error] when the asset is missing or compressed
+		std::span<const unsigned char> Data(std::string_view name) const;
+		std::string_view Text(std::string_view name) const;
+
+
+		//				[UTILITY]
+
+		// Copies or decompresses the asset into the destination of at least entry.size bytes,
+		// e.g. a mapped pixel unpack buffer. The blocks are spread over the jobs when there are any
+		// Exceptions: [runtime_error] on corrupted data
+		void Read(const AssetPackEntry& entry, std::span<unsigned char> destination, JobSystem* jobs = nullptr) const;
+
+		// Exceptions: [runtime_error] when the asset is missing or corrupted
+		std::vector<unsigned char> Read(std::string_view name, JobSystem* jobs = nullptr) const;
+
+		// Only the first bytes of the asset, up to the destination size, decompressing one block at most
+		// (e.g. a header to look at before the whole asset is read). Returns the part that was filled
+		// Exceptions: [runtime_error] on corrupted data
+		std::span<unsigned char> ReadPrefix(const AssetPackEntry& entry, std::span<unsigned char> destination) const;
+
+	private:
+		MappedFile m_File;
+		std::span<const AssetPackEntry> m_Entries;
+		std::span<const std::uint32_t> m_Buckets;
+		std::string_view m_Names;
+		std::uint32_t m_BucketBits{};
+	};
+
+	// Collects assets in memory and writes them as a pack
+	class AssetPackWriter
+	{
+	public:
+		//				[GETTERS]
+
+		std::size_t Count() const noexcept { return m_Assets.size(); }
+
+
+		//				[UTILITY]
+
+		// Compressed assets that would not get smaller are stored as they are
+		// Exceptions: [runtime_error] on a duplicate name
+		void Add(std::string name, std::vector<unsigned char> bytes, AssetCompression compression = AssetCompression::None);
+
+		// The name defaults to the path with forward slashes
+		// Exceptions: [runtime_error]
+		void AddFile(const std::string& path, std::string name = {});
+
+		// Every file under the directory, named by its path as given plus the relative part
+		// Exceptions: [runtime_error]
+		void AddDirectory(const std::string& directory);
+
+		// Exceptions: [runtime_error]
+		void Write(const std::string& path) const;
+
+	private:
+		struct PendingAsset
+		{
+			std::string name;
+			std::vector<unsigned char> bytes;	// as stored in the file
+			std::uint64_t size{};
+			AssetCompression compression{};
+		};
+
+		std::vector<PendingAsset> m_Assets;
+	};
+}
@@ -0,0 +1,31 @@
+#include "BatchSpriteRenderer.hpp"
+
+using namespace GameEngine;
+
+unsigned int GameEngine::CreateQuadIndexBuffer()
+{
+	std::vector<std::uint16_t> indices(quadsPerBatchDraw * 6);
+	for (std::size_t quad = 0; quad < quadsPerBatchDraw; ++quad)
+	{
+		const auto first = static_cast<std::uint16_t>(quad * 4);
+
+		indices[quad * 6 + 0] = first;
+		indices[quad * 6 + 1] = static_cast<std::uint16_t>(first + 1);
+		indices[quad * 6 + 2] = static_cast<std::uint16_t>(first + 2);
+		indices[quad * 6 + 3] = static_cast<std::uint16_t>(first + 2);
+		indices[quad * 6 + 4] = static_cast<std::uint16_t>(first + 3);
+		indices[quad * 6 + 5] = first;
+	}
+
+	unsigned int buffer{};
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint16_t), indices.data(), GL_STATIC_DRAW);
+
+	return buffer;
+}
+
+template class GameEngine::BatchSpriteRenderer<SpriteVertex, SpriteBackend::Batched>;
+template class GameEngine::BatchSpriteRenderer<PackedSpriteVertex, SpriteBackend::Packed>;
+template class GameEngine::BatchSpriteRenderer<PackedFlatSpriteVertex, SpriteBackend::PackedFlat>;
+template class GameEngine::BatchSpriteRenderer<PackedLayeredSpriteVertex, SpriteBackend::PackedHalf>;
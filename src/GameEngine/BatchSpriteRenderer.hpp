@@ -0,0 +1,317 @@
+#pragma once
+#include "SpriteRenderer.hpp"
+#include "SpriteVertex.hpp"
+#include "Shader.hpp"
+#include "CpuProfiler.hpp"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace GameEngine
+{
+	// 16-bit indices address 65536 vertices, bigger batches are drawn with a base vertex
+	inline constexpr std::size_t quadsPerBatchDraw{ 65536 / 4 };
+
+	// Creates a GL_ELEMENT_ARRAY_BUFFER with 16-bit indices of quadsPerBatchDraw quads
+	// (0, 1, 2, 2, 3, 0 pattern) and leaves it bound to the current VAO
+	unsigned int CreateQuadIndexBuffer();
+
+	// Batching backend templated on the vertex format. The corners are transformed on the CPU
+	// and written through TVertex::Encode, so each instantiation compiles down to a plain
+	// copy loop for its own format. TVertex has to provide Layout, shader and Encode().
+	// Sprites with an outline are emitted as triangle fans of the trimmed polygon
+	// with a streamed index buffer instead of the shared quad one
+	template <typename TVertex, SpriteBackend Kind>
+	class BatchSpriteRenderer final : public SpriteRenderer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Quantized formats store the position in positionStep units around the camera, coarser when
+		// the view is too big for the int16 range. Sprites out of that range start a new draw around
+		// themselves, with a coarser step if they are that big
+		explicit BatchSpriteRenderer(const std::string& shaderPath, float positionStep = 1.0f / 1024.0f);
+		~BatchSpriteRenderer() override;
+
+
+		//				[GETTERS]
+
+		SpriteBackend Backend() const noexcept override { return Kind; }
+
+
+		//				[UTILITY]
+
+		// Exceptions: [runtime_error] with the int16 formats, when a sprite position or size is not finite
+		void Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection) override;
+
+	private:
+		// Consecutive sprites drawn with one encoding
+		struct Segment
+		{
+			VertexEncoding encoding;
+			std::size_t firstVertex{};
+			std::size_t firstIndex{};
+		};
+
+		Shader m_Shader;
+		float m_PositionStep{};
+		unsigned int m_VAO{};
+		unsigned int m_VBO{};
+		unsigned int m_EBO{};
+		unsigned int m_OutlineEBO{};
+		std::size_t m_Capacity{};			// in vertices
+		std::size_t m_IndexCapacity{};		// in outline indices
+		std::vector<TVertex> m_Vertices;
+		std::vector<std::uint32_t> m_Indices;
+		std::vector<Segment> m_Segments;
+
+		// Step that stores a sprite of that reach in half the int16 range, doubled as often as needed
+		float PositionStep(float reach) const noexcept;
+
+		void WriteQuad(const Sprite& sprite, const VertexEncoding& encoding);
+		void WriteOutline(const Sprite& sprite, const VertexEncoding& encoding);
+	};
+
+	using FloatSpriteRenderer = BatchSpriteRenderer<SpriteVertex, SpriteBackend::Batched>;
+	using PackedSpriteRenderer = BatchSpriteRenderer<PackedSpriteVertex, SpriteBackend::Packed>;
+	using PackedFlatSpriteRenderer = BatchSpriteRenderer<PackedFlatSpriteVertex, SpriteBackend::PackedFlat>;
+	using PackedHalfSpriteRenderer = BatchSpriteRenderer<PackedLayeredSpriteVertex, SpriteBackend::PackedHalf>;
+
+	// Instantiated once in BatchSpriteRenderer.cpp
+	extern template class BatchSpriteRenderer<SpriteVertex, SpriteBackend::Batched>;
+	extern template class BatchSpriteRenderer<PackedSpriteVertex, SpriteBackend::Packed>;
+	extern template class BatchSpriteRenderer<PackedFlatSpriteVertex, SpriteBackend::PackedFlat>;
+	extern template class BatchSpriteRenderer<PackedLayeredSpriteVertex, SpriteBackend::PackedHalf>;
+
+
+	//						[CONSTRUCTORS]
+
+	template <typename TVertex, SpriteBackend Kind>
+	BatchSpriteRenderer<TVertex, Kind>::BatchSpriteRenderer(const std::string& shaderPath, float positionStep)
+		: m_Shader{ shaderPath + TVertex::shader, shaderPath + "sprite.frag" }
+		, m_PositionStep{ positionStep }
+	{
+		static_assert(sizeof(TVertex) == TVertex::Layout::stride, "BatchSpriteRenderer: the vertex does not match its layout");
+
+		if (positionStep <= 0)
+			throw std::runtime_error{ "BatchSpriteRenderer.BatchSpriteRenderer error: the position step is non-positive\n" };
+
+		glGenVertexArrays(1, &m_VAO);
+		glBindVertexArray(m_VAO);
+
+		glGenBuffers(1, &m_VBO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+		m_EBO = CreateQuadIndexBuffer();
+		glGenBuffers(1, &m_OutlineEBO);
+
+		TVertex::Layout::Apply();
+		glBindVertexArray(0);
+
+		m_Shader.Use();
+		m_Shader.SetInt("spriteTexture", 0);
+		m_Shader.SetInt("spritePalette", paletteTextureUnit);
+	}
+
+	template <typename TVertex, SpriteBackend Kind>
+	BatchSpriteRenderer<TVertex, Kind>::~BatchSpriteRenderer()
+	{
+		glDeleteVertexArrays(1, &m_VAO);
+		glDeleteBuffers(1, &m_VBO);
+		glDeleteBuffers(1, &m_EBO);
+		glDeleteBuffers(1, &m_OutlineEBO);
+		glDeleteProgram(m_Shader.GetID());
+	}
+
+
+	//						[UTILITY]
+
+	template <typename TVertex, SpriteBackend Kind>
+	void BatchSpriteRenderer<TVertex, Kind>::Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection)
+	{
+		if (sprites.empty())
+			return;
+
+		PROFILE_ZONE("BatchSpriteRenderer.Draw");
+
+		// The view matrix is a pure translation by -camera position and the projection orthographic
+		// (see SpriteQueue::VisibleArea()), so around the camera a step that fits half the view
+		// keeps everything visible inside the int16 range, however far the camera zooms out
+		const float halfView{ std::max(1.0f / std::abs(projection[0][0]), 1.0f / std::abs(projection[1][1])) };
+		const float viewStep{ PositionStep(halfView) };
+		const VertexEncoding cameraEncoding{
+			{ std::round(-view[3][0] / viewStep) * viewStep, std::round(-view[3][1] / viewStep) * viewStep },
+			viewStep };
+
+		const bool outlined{ std::any_of(sprites.begin(), sprites.end(), [](const Sprite& sprite)
+		{
+			return sprite.outline != nullptr && sprite.outline->count >= 3;
+		}) };
+
+		m_Vertices.clear();
+		m_Indices.clear();
+		m_Segments.clear();
+		m_Segments.push_back({ cameraEncoding, 0, 0 });
+		m_Vertices.reserve(sprites.size() * 4);
+		if (outlined)
+			m_Indices.reserve(sprites.size() * 6);
+
+		for (const Sprite& sprite : sprites)
+		{
+			if constexpr (TVertex::relativePosition)
+			{
+				// Corners and outline points are no farther from the center than half the diagonal
+				const glm::vec2 center{ sprite.position.x, sprite.position.y };
+				const float reach{ 0.5f * glm::length(sprite.size) };
+				if (!std::isfinite(center.x) || !std::isfinite(center.y) || !std::isfinite(reach))
+					throw std::runtime_error{ "BatchSpriteRenderer.Draw error: a sprite position or size is not finite\n" };
+
+				// Out of the range of the current draw, or too big for its step: a new one around the sprite
+				const float step{ std::max(viewStep, PositionStep(reach)) };
+				const VertexEncoding& current = m_Segments.back().encoding;
+				if (current.positionStep != step || !current.Covers(center, reach))
+				{
+					const VertexEncoding encoding{ { std::round(center.x / step) * step, std::round(center.y / step) * step }, step };
+					if (m_Vertices.empty())
+						m_Segments.back().encoding = encoding;
+					else
+						m_Segments.push_back({ encoding, m_Vertices.size(), m_Indices.size() });
+				}
+			}
+
+			if (outlined)
+				WriteOutline(sprite, m_Segments.back().encoding);
+			else
+				WriteQuad(sprite, m_Segments.back().encoding);
+		}
+
+		const std::size_t bytes{ m_Vertices.size() * sizeof(TVertex) };
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+		m_Capacity = std::max(m_Capacity, m_Vertices.size());
+		glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(TVertex), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_Vertices.data());
+
+		m_Shader.Use();
+		m_Shader.SetMat4f("view", glm::value_ptr(view));
+		m_Shader.SetMat4f("projection", glm::value_ptr(projection));
+		m_Shader.SetFloat("alphaCutoff", m_AlphaCutoff);
+		m_Shader.SetBool("paletteMode", m_PaletteMode);
+
+		glBindVertexArray(m_VAO);
+		if (outlined)
+		{
+			const std::size_t indexBytes{ m_Indices.size() * sizeof(std::uint32_t) };
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OutlineEBO);
+			m_IndexCapacity = std::max(m_IndexCapacity, m_Indices.size());
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_IndexCapacity * sizeof(std::uint32_t), nullptr, GL_STREAM_DRAW);
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexBytes, m_Indices.data());
+			m_Stats.bytesUploaded += indexBytes;
+		}
+		else
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+		for (std::size_t segment = 0; segment < m_Segments.size(); ++segment)
+		{
+			const Segment& current = m_Segments[segment];
+			const bool last{ segment + 1 == m_Segments.size() };
+			const std::size_t vertexEnd{ last ? m_Vertices.size() : m_Segments[segment + 1].firstVertex };
+			const std::size_t indexEnd{ last ? m_Indices.size() : m_Segments[segment + 1].firstIndex };
+
+			m_Shader.SetFloat4("positionOrigin", current.encoding.origin.x, current.encoding.origin.y, 0.0f, 0.0f);
+			m_Shader.SetFloat("positionStep", current.encoding.positionStep);
+
+			if (outlined)
+			{
+				glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexEnd - current.firstIndex), GL_UNSIGNED_INT,
+					reinterpret_cast<const void*>(current.firstIndex * sizeof(std::uint32_t)));
+				m_Stats.drawCalls += 1;
+				continue;
+			}
+
+			const std::size_t quads{ (vertexEnd - current.firstVertex) / 4 };
+			for (std::size_t first = 0; first < quads; first += quadsPerBatchDraw)
+			{
+				const std::size_t count{ std::min(quadsPerBatchDraw, quads - first) };
+				glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(count * 6), GL_UNSIGNED_SHORT, nullptr,
+					static_cast<GLint>(current.firstVertex + first * 4));
+				m_Stats.drawCalls += 1;
+			}
+		}
+		glBindVertexArray(0);
+
+		m_Stats.sprites += sprites.size();
+		m_Stats.vertices += m_Vertices.size();
+		m_Stats.bytesUploaded += bytes;
+	}
+
+
+	//						[PRIVATE]
+
+	template <typename TVertex, SpriteBackend Kind>
+	float BatchSpriteRenderer<TVertex, Kind>::PositionStep(float reach) const noexcept
+	{
+		// The other half is left for the neighbours to join the same draw
+		float step{ m_PositionStep };
+		while (reach > 0.5f * maxInt16Steps * step)
+			step *= 2.0f;
+
+		return step;
+	}
+
+	template <typename TVertex, SpriteBackend Kind>
+	void BatchSpriteRenderer<TVertex, Kind>::WriteQuad(const Sprite& sprite, const VertexEncoding& encoding)
+	{
+		const float c{ std::cos(sprite.rotation) };
+		const float s{ std::sin(sprite.rotation) };
+		const glm::vec2 right{ c * sprite.size.x * 0.5f, s * sprite.size.x * 0.5f };
+		const glm::vec2 up{ -s * sprite.size.y * 0.5f, c * sprite.size.y * 0.5f };
+		const glm::vec2 center{ sprite.position.x, sprite.position.y };
+		const float z{ sprite.position.z };
+
+		// Top-left, top-right, bottom-right, bottom-left
+		m_Vertices.push_back(TVertex::Encode({ center - right + up, z }, { sprite.uvRect.x, sprite.uvRect.w }, sprite.tint, encoding));
+		m_Vertices.push_back(TVertex::Encode({ center + right + up, z }, { sprite.uvRect.z, sprite.uvRect.w }, sprite.tint, encoding));
+		m_Vertices.push_back(TVertex::Encode({ center + right - up, z }, { sprite.uvRect.z, sprite.uvRect.y }, sprite.tint, encoding));
+		m_Vertices.push_back(TVertex::Encode({ center - right - up, z }, { sprite.uvRect.x, sprite.uvRect.y }, sprite.tint, encoding));
+	}
+
+	template <typename TVertex, SpriteBackend Kind>
+	void BatchSpriteRenderer<TVertex, Kind>::WriteOutline(const Sprite& sprite, const VertexEncoding& encoding)
+	{
+		const auto first = static_cast<std::uint32_t>(m_Vertices.size());
+
+		if (sprite.outline == nullptr || sprite.outline->count < 3)
+		{
+			WriteQuad(sprite, encoding);
+			m_Indices.insert(m_Indices.end(), { first, first + 1, first + 2, first + 2, first + 3, first });
+			return;
+		}
+
+		const float c{ std::cos(sprite.rotation) };
+		const float s{ std::sin(sprite.rotation) };
+		const glm::vec2 uvMin{ sprite.uvRect.x, sprite.uvRect.y };
+		const glm::vec2 uvSize{ sprite.uvRect.z - sprite.uvRect.x, sprite.uvRect.w - sprite.uvRect.y };
+
+		const SpriteOutline& outline = *sprite.outline;
+		for (std::uint8_t i = 0; i < outline.count; ++i)
+		{
+			// Outline points are in [0; 1] frame space, the sprite center is at [0.5; 0.5]
+			const glm::vec2 offset{ (outline.points[i] - glm::vec2{ 0.5f }) * sprite.size };
+			const glm::vec3 position{
+				sprite.position.x + c * offset.x - s * offset.y,
+				sprite.position.y + s * offset.x + c * offset.y,
+				sprite.position.z };
+
+			m_Vertices.push_back(TVertex::Encode(position, uvMin + outline.points[i] * uvSize, sprite.tint, encoding));
+		}
+
+		// Convex polygon, so a fan around the first point
+		for (std::uint32_t i = 1; i + 1 < outline.count; ++i)
+			m_Indices.insert(m_Indices.end(), { first, first + i, first + i + 1 });
+	}
+}
@@ -0,0 +1,272 @@
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+static constexpr int blockPixels{ 16 };
+
+static std::uint16_t PackRgb565(const float color[3]) noexcept
+{
+	auto quantize = [](float value, unsigned max)
+	{
+		return static_cast<unsigned>(std::clamp(value, 0.0f, 255.0f) * max / 255.0f + 0.5f);
+	};
+
+	return static_cast<std::uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+}
+
+// Bit replication, the way the hardware expands the endpoints
+static void UnpackRgb565(std::uint16_t color, unsigned char* out) noexcept
+{
+	const unsigned value{ color }, red{ value >> 11 }, green{ (value >> 5) & 63u }, blue{ value & 31u };
+	out[0] = static_cast<unsigned char>((red << 3) | (red >> 2));
+	out[1] = static_cast<unsigned char>((green << 2) | (green >> 4));
+	out[2] = static_cast<unsigned char>((blue << 3) | (blue >> 2));
+	out[3] = 255;
+}
+
+// The 3-color mode (first endpoint not greater) has black transparent as the fourth entry, BC3 never uses it
+static void ColorPalette(std::uint16_t color0, std::uint16_t color1, bool fourColors, unsigned char palette[4][4]) noexcept
+{
+	UnpackRgb565(color0, palette[0]);
+	UnpackRgb565(color1, palette[1]);
+	for (int c = 0; c < 3; ++c)
+	{
+		if (fourColors)
+		{
+			palette[2][c] = static_cast<unsigned char>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+			palette[3][c] = static_cast<unsigned char>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+		}
+		else
+		{
+			palette[2][c] = static_cast<unsigned char>((palette[0][c] + palette[1][c]) / 2);
+			palette[3][c] = 0;
+		}
+	}
+	palette[2][3] = 255;
+	palette[3][3] = fourColors ? 255 : 0;
+}
+
+// Endpoints on the principal axis of the block colors, pulled in by 1/16 of the range
+// so the interpolated entries land closer to the pixels. Always the 4-color mode
+static void EncodeColorBlock(const unsigned char block[blockPixels][4], unsigned char* out) noexcept
+{
+	float mean[3]{};
+	for (int i = 0; i < blockPixels; ++i)
+		for (int c = 0; c < 3; ++c)
+			mean[c] += block[i][c] / static_cast<float>(blockPixels);
+
+	// Covariance: xx xy xz yy yz zz
+	float covariance[6]{};
+	for (int i = 0; i < blockPixels; ++i)
+	{
+		const float r{ block[i][0] - mean[0] }, g{ block[i][1] - mean[1] }, b{ block[i][2] - mean[2] };
+		covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+		covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+	}
+
+	float axis[3]{ 1.0f, 1.0f, 1.0f };
+	for (int iteration = 0; iteration < 8; ++iteration)
+	{
+		const float next[3]{
+			covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+			covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+			covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2] };
+		const float length{ std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) }) };
+		if (length < 1e-4f)
+			break;
+		for (int c = 0; c < 3; ++c)
+			axis[c] = next[c] / length;
+	}
+	const float axisLengthSquared{ axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] };
+
+	float low{ 0.0f }, high{ 0.0f };
+	for (int i = 0; i < blockPixels; ++i)
+	{
+		const float t{ ((block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2]) / axisLengthSquared };
+		low = std::min(low, t);
+		high = std::max(high, t);
+	}
+	const float inset{ (high - low) / 16.0f };
+	low += inset;
+	high -= inset;
+
+	float endpoint0[3], endpoint1[3];
+	for (int c = 0; c < 3; ++c)
+	{
+		endpoint0[c] = mean[c] + axis[c] * high;
+		endpoint1[c] = mean[c] + axis[c] * low;
+	}
+
+	std::uint16_t color0{ PackRgb565(endpoint0) }, color1{ PackRgb565(endpoint1) };
+	if (color0 < color1)
+		std::swap(color0, color1);
+
+	std::uint32_t indices{};
+	if (color0 != color1)
+	{
+		unsigned char palette[4][4];
+		ColorPalette(color0, color1, true, palette);
+		for (int i = 0; i < blockPixels; ++i)
+		{
+			int best{};
+			int bestDistance{ 1 << 30 };
+			for (int entry = 0; entry < 4; ++entry)
+			{
+				const int r{ block[i][0] - palette[entry][0] }, g{ block[i][1] - palette[entry][1] }, b{ block[i][2] - palette[entry][2] };
+				const int distance{ r * r + g * g + b * b };
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = entry;
+				}
+			}
+			indices |= static_cast<std::uint32_t>(best) << (2 * i);
+		}
+	}
+
+	out[0] = static_cast<unsigned char>(color0);
+	out[1] = static_cast<unsigned char>(color0 >> 8);
+	out[2] = static_cast<unsigned char>(color1);
+	out[3] = static_cast<unsigned char>(color1 >> 8);
+	for (int i = 0; i < 4; ++i)
+		out[4 + i] = static_cast<unsigned char>(indices >> (8 * i));
+}
+
+// The 8-value mode: maximum and minimum alpha as endpoints, 3-bit indices in between
+static void EncodeAlphaBlock(const unsigned char block[blockPixels][4], unsigned char* out) noexcept
+{
+	int low{ 255 }, high{ 0 };
+	for (int i = 0; i < blockPixels; ++i)
+	{
+		low = std::min<int>(low, block[i][3]);
+		high = std::max<int>(high, block[i][3]);
+	}
+
+	std::uint64_t indices{};
+	if (high > low)
+	{
+		const int range{ high - low };
+		for (int i = 0; i < blockPixels; ++i)
+		{
+			// Step 7 is the first endpoint (index 0), step 0 the second one (index 1), step k in between is index 8 - k
+			const int step{ ((block[i][3] - low) * 7 + range / 2) / range };
+			const int index{ step == 7 ? 0 : step == 0 ? 1 : 8 - step };
+			indices |= static_cast<std::uint64_t>(index) << (3 * i);
+		}
+	}
+
+	out[0] = static_cast<unsigned char>(high);
+	out[1] = static_cast<unsigned char>(low);
+	for (int i = 0; i < 6; ++i)
+		out[2 + i] = static_cast<unsigned char>(indices >> (8 * i));
+}
+
+static void DecodeColorBlock(const unsigned char* in, bool forceFourColors, unsigned char block[blockPixels][4]) noexcept
+{
+	const std::uint16_t color0{ static_cast<std::uint16_t>(in[0] | (in[1] << 8)) };
+	const std::uint16_t color1{ static_cast<std::uint16_t>(in[2] | (in[3] << 8)) };
+	const std::uint32_t indices{ in[4] | (in[5] << 8u) | (in[6] << 16u) | (static_cast<std::uint32_t>(in[7]) << 24u) };
+
+	unsigned char palette[4][4];
+	ColorPalette(color0, color1, forceFourColors || color0 > color1, palette);
+	for (int i = 0; i < blockPixels; ++i)
+		std::copy_n(palette[(indices >> (2 * i)) & 3u], 4, block[i]);
+}
+
+static void DecodeAlphaBlock(const unsigned char* in, unsigned char block[blockPixels][4]) noexcept
+{
+	const int alpha0{ in[0] }, alpha1{ in[1] };
+	int values[8]{ alpha0, alpha1 };
+	if (alpha0 > alpha1)
+	{
+		for (int i = 2; i < 8; ++i)
+			values[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+	}
+	else
+	{
+		for (int i = 2; i < 6; ++i)
+			values[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+		values[6] = 0;
+		values[7] = 255;
+	}
+
+	std::uint64_t indices{};
+	for (int i = 0; i < 6; ++i)
+		indices |= static_cast<std::uint64_t>(in[2 + i]) << (8 * i);
+	for (int i = 0; i < blockPixels; ++i)
+		block[i][3] = static_cast<unsigned char>(values[(indices >> (3 * i)) & 7u]);
+}
+
+std::vector<unsigned char> GameEngine::EncodeBlocks(const unsigned char* pixels, int width, int height, int channels, BlockFormat format)
+{
+	if (format == BlockFormat::None || (channels != 3 && channels != 4) || width <= 0 || height <= 0)
+		throw std::runtime_error("EncodeBlocks error: unsupported format");
+
+	std::vector<unsigned char> blocks(BlockCompressedSize(width, height, format));
+	unsigned char* out = blocks.data();
+	for (int blockY = 0; blockY < height; blockY += 4)
+	{
+		for (int blockX = 0; blockX < width; blockX += 4)
+		{
+			unsigned char block[blockPixels][4];
+			for (int i = 0; i < blockPixels; ++i)
+			{
+				const int x{ std::min(blockX + i % 4, width - 1) };
+				const int y{ std::min(blockY + i / 4, height - 1) };
+				const unsigned char* pixel = pixels + (static_cast<std::size_t>(y) * width + x) * channels;
+				std::copy_n(pixel, channels, block[i]);
+				if (channels == 3)
+					block[i][3] = 255;
+			}
+
+			if (format == BlockFormat::BC3)
+			{
+				EncodeAlphaBlock(block, out);
+				out += 8;
+			}
+			EncodeColorBlock(block, out);
+			out += 8;
+		}
+	}
+
+	return blocks;
+}
+
+std::vector<unsigned char> GameEngine::DecodeBlocks(std::span<const unsigned char> blocks, int width, int height, BlockFormat format)
+{
+	if (format == BlockFormat::None || width <= 0 || height <= 0)
+		throw std::runtime_error("DecodeBlocks error: unsupported format");
+	if (blocks.size() < BlockCompressedSize(width, height, format))
+		throw std::runtime_error("DecodeBlocks error: the data is cut off");
+
+	std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+	const unsigned char* in = blocks.data();
+	for (int blockY = 0; blockY < height; blockY += 4)
+	{
+		for (int blockX = 0; blockX < width; blockX += 4)
+		{
+			unsigned char block[blockPixels][4];
+			if (format == BlockFormat::BC3)
+			{
+				DecodeColorBlock(in + 8, true, block);
+				DecodeAlphaBlock(in, block);
+			}
+			else
+				DecodeColorBlock(in, false, block);
+			in += BlockBytes(format);
+
+			for (int i = 0; i < blockPixels; ++i)
+			{
+				const int x{ blockX + i % 4 }, y{ blockY + i / 4 };
+				if (x < width && y < height)
+					std::copy_n(block[i], 4, &pixels[(static_cast<std::size_t>(y) * width + x) * 4]);
+			}
+		}
+	}
+
+	return pixels;
+}
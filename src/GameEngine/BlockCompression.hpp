@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GameEngine
+{
+	// S3TC block formats, 4x4 pixels per block. They stay compressed in VRAM and the
+	// sampler decodes them, so they cut memory and sampling bandwidth of large textures
+	enum class BlockFormat : std::uint8_t
+	{
+		None,		// plain RGB8 or RGBA8 pixels
+		BC1,		// 8 bytes per block: two RGB565 endpoints and 2-bit indices, opaque (DXT1)
+		BC3,		// 16 bytes per block: BC1 colors plus interpolated 8-bit alpha (DXT5)
+	};
+
+	constexpr std::size_t BlockBytes(BlockFormat format) noexcept
+	{
+		return format == BlockFormat::BC1 ? 8 : 16;
+	}
+
+	// Blocks cover partial ones at the right and top edges
+	constexpr std::size_t BlockCompressedSize(int width, int height, BlockFormat format) noexcept
+	{
+		return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format);
+	}
+
+	// Encodes RGB or RGBA pixels, rows in memory order. The edge pixels are repeated to fill partial blocks
+	// Exceptions: [runtime_error]
+	std::vector<unsigned char> EncodeBlocks(const unsigned char* pixels, int width, int height, int channels, BlockFormat format);
+
+	// Decodes to RGBA pixels, the fallback for GPUs without S3TC
+	// Exceptions: [runtime_error] when the data is too short
+	std::vector<unsigned char> DecodeBlocks(std::span<const unsigned char> blocks, int width, int height, BlockFormat format);
+}
@@ -0,0 +1,133 @@
+#include "BufferSpriteRenderer.hpp"
+
+#include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <bit>
+
+using namespace GameEngine;
+
+// Each sprite occupies two RGBA32UI texels
+static constexpr std::size_t texelsPerSprite{ 2 };
+
+// Texture unit that holds the sprite data, unit 0 is the sprite texture itself
+static constexpr int dataTextureUnit{ 1 };
+
+
+//						[CONSTRUCTORS]
+
+BufferSpriteRenderer::BufferSpriteRenderer(const std::string& shaderPath, bool instanced)
+	: m_Shader{ shaderPath + "spriteBuffer.vert", shaderPath + "sprite.frag" }
+	, m_Instanced{ instanced }
+{
+	int maxTexels{};
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+	m_MaxBatch = static_cast<std::size_t>(maxTexels) / texelsPerSprite;
+
+	// Core profile refuses to draw without a VAO, even an empty one
+	glGenVertexArrays(1, &m_VAO);
+
+	glGenBuffers(1, &m_Buffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_Buffer);
+	glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+
+	glGenTextures(1, &m_BufferTexture);
+	glBindTexture(GL_TEXTURE_BUFFER, m_BufferTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, m_Buffer);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	m_Shader.Use();
+	m_Shader.SetInt("spriteTexture", 0);
+	m_Shader.SetInt("spritePalette", paletteTextureUnit);
+	m_Shader.SetInt("spriteData", dataTextureUnit);
+	m_Shader.SetBool("instanced", m_Instanced);
+}
+
+BufferSpriteRenderer::~BufferSpriteRenderer()
+{
+	glDeleteTextures(1, &m_BufferTexture);
+	glDeleteBuffers(1, &m_Buffer);
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteProgram(m_Shader.GetID());
+}
+
+
+//						[GETTERS]
+
+SpriteBackend BufferSpriteRenderer::Backend() const noexcept
+{
+	return m_Instanced ? SpriteBackend::TextureBufferInstanced : SpriteBackend::TextureBuffer;
+}
+
+
+//						[UTILITY]
+
+void BufferSpriteRenderer::Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection)
+{
+	if (sprites.empty())
+		return;
+
+	m_Texels.resize(sprites.size() * texelsPerSprite);
+	for (std::size_t i = 0; i < sprites.size(); ++i)
+	{
+		const Sprite& sprite = sprites[i];
+
+		m_Texels[i * texelsPerSprite] =
+		{
+			std::bit_cast<std::uint32_t>(sprite.position.x),
+			std::bit_cast<std::uint32_t>(sprite.position.y),
+			std::bit_cast<std::uint32_t>(sprite.position.z),
+			std::bit_cast<std::uint32_t>(sprite.rotation)
+		};
+
+		m_Texels[i * texelsPerSprite + 1] =
+		{
+			glm::packHalf1x16(sprite.size.x) | (static_cast<std::uint32_t>(glm::packHalf1x16(sprite.size.y)) << 16),
+			glm::packUnorm1x16(sprite.uvRect.x) | (static_cast<std::uint32_t>(glm::packUnorm1x16(sprite.uvRect.y)) << 16),
+			glm::packUnorm1x16(sprite.uvRect.z) | (static_cast<std::uint32_t>(glm::packUnorm1x16(sprite.uvRect.w)) << 16),
+			sprite.tint
+		};
+	}
+
+	m_Shader.Use();
+	m_Shader.SetMat4f("view", glm::value_ptr(view));
+	m_Shader.SetMat4f("projection", glm::value_ptr(projection));
+	m_Shader.SetFloat("alphaCutoff", m_AlphaCutoff);
+	m_Shader.SetBool("paletteMode", m_PaletteMode);
+
+	glActiveTexture(GL_TEXTURE0 + dataTextureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, m_BufferTexture);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_Buffer);
+	glBindVertexArray(m_VAO);
+
+	// Drivers only guarantee 64K texels per buffer texture, so big layers are split
+	for (std::size_t first = 0; first < sprites.size(); first += m_MaxBatch)
+	{
+		const std::size_t count{ std::min(m_MaxBatch, sprites.size() - first) };
+		const std::size_t bytes{ count * texelsPerSprite * sizeof(Texel) };
+
+		if (count > m_Capacity)
+			m_Capacity = count;
+
+		// Orphaning keeps the previous batch alive for the GPU while this one is written
+		glBufferData(GL_TEXTURE_BUFFER, m_Capacity * texelsPerSprite * sizeof(Texel), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, m_Texels.data() + first * texelsPerSprite);
+
+		if (m_Instanced)
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+		else
+			glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count * 6));
+
+		m_Stats.drawCalls += 1;
+		m_Stats.bytesUploaded += bytes;
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	m_Stats.sprites += sprites.size();
+	m_Stats.vertices += sprites.size() * (m_Instanced ? 4 : 6);
+}
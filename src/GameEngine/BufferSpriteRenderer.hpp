@@ -0,0 +1,45 @@
+#pragma once
+#include "SpriteRenderer.hpp"
+#include "Shader.hpp"
+#include <vector>
+
+namespace GameEngine
+{
+	// Vertex pulling backend: sprites are packed into a GL_TEXTURE_BUFFER
+	// (32 bytes per sprite: float position and rotation, half-float size,
+	// unorm16 UV rectangle, RGBA8 tint) and the vertex shader fetches them
+	// by gl_VertexID or gl_InstanceID. The VAO has no attributes at all
+	class BufferSpriteRenderer final : public SpriteRenderer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		BufferSpriteRenderer(const std::string& shaderPath, bool instanced);
+		~BufferSpriteRenderer() override;
+
+
+		//				[GETTERS]
+
+		SpriteBackend Backend() const noexcept override;
+
+
+		//				[UTILITY]
+
+		void Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection) override;
+
+	private:
+		struct Texel
+		{
+			std::uint32_t x, y, z, w;
+		};
+
+		Shader m_Shader;
+		bool m_Instanced{};
+		unsigned int m_VAO{};
+		unsigned int m_Buffer{};
+		unsigned int m_BufferTexture{};
+		std::size_t m_Capacity{};		// in sprites
+		std::size_t m_MaxBatch{};		// sprites per draw call, limited by GL_MAX_TEXTURE_BUFFER_SIZE
+		std::vector<Texel> m_Texels;
+	};
+}
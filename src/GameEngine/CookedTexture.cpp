@@ -0,0 +1,175 @@
+#include "CookedTexture.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace GameEngine;
+
+static std::size_t LevelSize(int width, int height, int channels) noexcept
+{
+	return static_cast<std::size_t>(width) * height * channels;
+}
+
+static std::size_t LevelSize(int width, int height, int channels, BlockFormat format) noexcept
+{
+	return format == BlockFormat::None ? LevelSize(width, height, channels) : BlockCompressedSize(width, height, format);
+}
+
+static int LevelExtent(int extent, int level) noexcept
+{
+	return std::max(1, extent >> level);
+}
+
+static void PremultiplyAlpha(std::vector<unsigned char>& pixels) noexcept
+{
+	for (std::size_t i = 0; i < pixels.size(); i += 4)
+	{
+		const unsigned alpha{ pixels[i + 3] };
+		for (std::size_t c = 0; c < 3; ++c)
+			pixels[i + c] = static_cast<unsigned char>((pixels[i + c] * alpha + 127) / 255);
+	}
+}
+
+// Pixel art and palettizable images stop at 256 colors, photographs and renders go far beyond
+static bool IsPhotographic(const Image& image)
+{
+	std::unordered_set<std::uint32_t> colors;
+	for (std::size_t i = 0; i < image.pixels.size(); i += image.channels)
+	{
+		std::uint32_t color{};
+		std::memcpy(&color, &image.pixels[i], image.channels);
+		colors.insert(color);
+		if (colors.size() > 256)
+			return true;
+	}
+
+	return false;
+}
+
+static BlockFormat ChooseBlockFormat(const Image& image, AlphaClass alpha, const CookSettings& settings)
+{
+	if (!settings.blockCompression || std::min(image.width, image.height) < settings.blockCompressionMinExtent || !IsPhotographic(image))
+		return BlockFormat::None;
+
+	return alpha == AlphaClass::Opaque ? BlockFormat::BC1 : BlockFormat::BC3;
+}
+
+// Averages 2x2 blocks of the level above, the last row or column is repeated for odd sizes
+static std::vector<unsigned char> Downsample(const std::vector<unsigned char>& source, int width, int height, int channels)
+{
+	const int newWidth{ std::max(1, width / 2) };
+	const int newHeight{ std::max(1, height / 2) };
+	std::vector<unsigned char> level(LevelSize(newWidth, newHeight, channels));
+
+	for (int y = 0; y < newHeight; ++y)
+	{
+		const int y0{ std::min(y * 2, height - 1) };
+		const int y1{ std::min(y * 2 + 1, height - 1) };
+		for (int x = 0; x < newWidth; ++x)
+		{
+			const int x0{ std::min(x * 2, width - 1) };
+			const int x1{ std::min(x * 2 + 1, width - 1) };
+			for (int c = 0; c < channels; ++c)
+			{
+				const unsigned sum{ 2u + source[(static_cast<std::size_t>(y0) * width + x0) * channels + c]
+					+ source[(static_cast<std::size_t>(y0) * width + x1) * channels + c]
+					+ source[(static_cast<std::size_t>(y1) * width + x0) * channels + c]
+					+ source[(static_cast<std::size_t>(y1) * width + x1) * channels + c] };
+				level[(static_cast<std::size_t>(y) * newWidth + x) * channels + c] = static_cast<unsigned char>(sum / 4);
+			}
+		}
+	}
+
+	return level;
+}
+
+std::vector<unsigned char> GameEngine::CookTexture(const Image& image, const CookSettings& settings)
+{
+	if (image.channels != 3 && image.channels != 4)
+		throw std::runtime_error("CookTexture error: only RGB and RGBA images are supported");
+	if (image.width <= 0 || image.height <= 0 || image.pixels.size() != LevelSize(image.width, image.height, image.channels))
+		throw std::runtime_error("CookTexture error: the image size does not match its pixels");
+
+	CookedTextureHeader header{};
+	header.width = static_cast<std::uint32_t>(image.width);
+	header.height = static_cast<std::uint32_t>(image.height);
+	header.channels = static_cast<std::uint32_t>(image.channels);
+	header.alpha = ClassifyAlpha(image.pixels.data(), image.width, image.channels, 0, 0, image.width, image.height);
+	header.blockFormat = ChooseBlockFormat(image, header.alpha, settings);
+
+	std::vector<unsigned char> level{ image.pixels };
+	if (image.channels == 4 && settings.premultiplyAlpha)
+	{
+		PremultiplyAlpha(level);
+		header.premultipliedAlpha = 1;
+	}
+
+	const int maxExtent{ std::max(image.width, image.height) };
+	int levelCount{ 1 };
+	while (settings.mipmaps && (maxExtent >> levelCount) > 0)
+		++levelCount;
+	header.levelCount = static_cast<std::uint32_t>(levelCount);
+
+	std::vector<unsigned char> blob(sizeof(header));
+	std::memcpy(blob.data(), &header, sizeof(header));
+	for (int i = 0; i < levelCount; ++i)
+	{
+		if (header.blockFormat != BlockFormat::None)
+		{
+			const std::vector<unsigned char> blocks{ EncodeBlocks(level.data(), LevelExtent(image.width, i), LevelExtent(image.height, i),
+				image.channels, header.blockFormat) };
+			blob.insert(blob.end(), blocks.begin(), blocks.end());
+		}
+		else
+			blob.insert(blob.end(), level.begin(), level.end());
+		if (i + 1 < levelCount)
+			level = Downsample(level, LevelExtent(image.width, i), LevelExtent(image.height, i), image.channels);
+	}
+
+	return blob;
+}
+
+CookedTexture GameEngine::ParseCookedTexture(std::span<const unsigned char> blob)
+{
+	return ParseCookedTexture(blob, blob);
+}
+
+CookedTexture GameEngine::ParseCookedTexture(std::span<const unsigned char> headerBytes, std::span<const unsigned char> blob)
+{
+	CookedTextureHeader header{};
+	if (headerBytes.size() < sizeof(header) || blob.size() < sizeof(header))
+		throw std::runtime_error("ParseCookedTexture error: not a cooked texture");
+	std::memcpy(&header, headerBytes.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, CookedTextureHeader{}.magic, sizeof(header.magic)) != 0)
+		throw std::runtime_error("ParseCookedTexture error: not a cooked texture");
+	if (header.version != CookedTextureHeader::currentVersion)
+		throw std::runtime_error("ParseCookedTexture error: unsupported version, the assets have to be cooked again");
+	if ((header.channels != 3 && header.channels != 4) || header.width == 0 || header.height == 0
+		|| header.width > 65536 || header.height > 65536 || header.levelCount == 0 || header.levelCount > 17
+		|| header.blockFormat > BlockFormat::BC3)
+		throw std::runtime_error("ParseCookedTexture error: corrupted header");
+
+	CookedTexture texture{};
+	texture.width = static_cast<int>(header.width);
+	texture.height = static_cast<int>(header.height);
+	texture.channels = static_cast<int>(header.channels);
+	texture.alpha = header.alpha;
+	texture.premultipliedAlpha = header.premultipliedAlpha != 0;
+	texture.blockFormat = header.blockFormat;
+
+	std::size_t offset{ sizeof(header) };
+	for (int i = 0; i < static_cast<int>(header.levelCount); ++i)
+	{
+		const std::size_t size{ LevelSize(LevelExtent(texture.width, i), LevelExtent(texture.height, i), texture.channels, texture.blockFormat) };
+		if (size > blob.size() - offset)
+			throw std::runtime_error("ParseCookedTexture error: the mip chain is cut off");
+
+		texture.levels.push_back(blob.subspan(offset, size));
+		offset += size;
+	}
+
+	return texture;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "AlphaClass.hpp"
+#include "BlockCompression.hpp"
+#include "Image.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace GameEngine
+{
+	// Texture blob made offline by the cooker, little endian:
+	// header | mip levels from the largest, each tightly packed rows from bottom to top
+	// or, block compressed, rows of 4x4 blocks from bottom to top
+	struct CookedTextureHeader
+	{
+		static constexpr std::uint32_t currentVersion{ 2 };
+
+		char			magic[4]{ 'C', 'T', 'E', 'X' };
+		std::uint32_t	version{ currentVersion };
+		std::uint32_t	width{};
+		std::uint32_t	height{};
+		std::uint32_t	channels{};			// 3 or 4, the upload format is GL_RGB8 or GL_RGBA8
+		std::uint32_t	levelCount{};		// 1 when the mip chain was not wanted
+		AlphaClass		alpha{};			// classified before premultiplying
+		std::uint8_t	premultipliedAlpha{};
+		BlockFormat		blockFormat{};		// BC1 for opaque textures, BC3 for the others
+		std::uint8_t	reserved[5]{};
+	};
+
+	static_assert(sizeof(CookedTextureHeader) == 32 && std::is_trivially_copyable_v<CookedTextureHeader>);
+
+	struct CookSettings
+	{
+		// RGBA only. Off by default: the game shaders and blends expect straight alpha,
+		// only the sprite translucent pass picks the blend from Texture::PremultipliedAlpha()
+		bool premultiplyAlpha{ false };
+		bool mipmaps{ true };				// box-filtered down to 1x1
+		// Photographic textures of at least that size are block compressed. Pixel art
+		// (no more than 256 colors) and small images keep their exact colors
+		bool blockCompression{ true };
+		int blockCompressionMinExtent{ 256 };
+	};
+
+	// Parsed blob, the levels point into the blob memory (e.g. a mapped AssetPack)
+	struct CookedTexture
+	{
+		int width{};
+		int height{};
+		int channels{};
+		AlphaClass alpha{};
+		bool premultipliedAlpha{};
+		BlockFormat blockFormat{};
+		std::vector<std::span<const unsigned char>> levels;
+	};
+
+	// The pack name of the cooked version of a source image
+	inline std::string CookedTextureName(std::string_view sourceName)
+	{
+		return std::string{ sourceName } + ".ctex";
+	}
+
+	// Premultiplies, builds the mip chain of an RGB or RGBA image and block compresses it
+	// Exceptions: [runtime_error]
+	std::vector<unsigned char> CookTexture(const Image& image, const CookSettings& settings);
+
+	// Checks the header and the level sizes against the blob size
+	// Exceptions: [runtime_error]
+	CookedTexture ParseCookedTexture(std::span<const unsigned char> blob);
+
+	// Same with the header bytes copied out of the blob beforehand, the blob itself is not read
+	// (e.g. a write-only mapped pixel unpack buffer), the levels only point into it
+	// Exceptions: [runtime_error]
+	CookedTexture ParseCookedTexture(std::span<const unsigned char> header, std::span<const unsigned char> blob);
+}
@@ -0,0 +1,235 @@
+#include "CpuProfiler.hpp"
+#include "TraceWriter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <stdexcept>
+#include <string_view>
+
+using namespace GameEngine;
+
+static thread_local std::uint32_t zoneDepth{};
+
+
+//						[CONSTRUCTORS]
+
+CpuProfiler& CpuProfiler::Instance()
+{
+	static CpuProfiler profiler;
+	return profiler;
+}
+
+CpuZone::CpuZone(const char* name) noexcept
+	: m_Name{ name }, m_Begin{ CpuProfiler::Now() }, m_Depth{ zoneDepth++ }, m_Counts{ PerfCounters::Read() }
+{
+}
+
+CpuZone::~CpuZone()
+{
+	// Counters first, the rest of the bookkeeping is not part of the zone
+	const PerfCounts counts{ PerfCounters::Read() - m_Counts };
+
+	--zoneDepth;
+	CpuProfiler::Instance().Record({ m_Name, m_Begin, CpuProfiler::Now(), m_Depth, counts });
+}
+
+
+//						[UTILITY]
+
+void CpuProfiler::MarkFrame() noexcept
+{
+	const std::uint64_t frame{ m_FrameCount.load(std::memory_order_relaxed) };
+	m_FrameStarts[frame % framesKept].store(Now(), std::memory_order_relaxed);
+	m_FrameCount.store(frame + 1, std::memory_order_release);
+}
+
+void CpuProfiler::NameThread(const std::string& name)
+{
+	ThreadRing& ring = CurrentRing();
+
+	std::lock_guard lock{ m_RingsMutex };
+	ring.threadName = name;
+}
+
+void CpuProfiler::Record(const ProfileEvent& event) noexcept
+{
+	ThreadRing& ring = CurrentRing();
+
+	// Only the owning thread writes, readers check head again after copying
+	const std::uint64_t head{ ring.head.load(std::memory_order_relaxed) };
+	ring.events[head % eventsPerThread] = event;
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+void CpuProfiler::Marker(const char* category, std::string detail)
+{
+	const std::uint32_t threadId{ CurrentRing().threadId };
+
+	std::lock_guard lock{ m_MarkersMutex };
+	if (m_Markers.size() < markersKept)
+		m_Markers.resize(markersKept);
+	m_Markers[m_MarkerCount % markersKept] = { Now(), threadId, category, std::move(detail) };
+	++m_MarkerCount;
+}
+
+std::uint64_t CpuProfiler::FrameStart(std::size_t frameCount) const noexcept
+{
+	const std::uint64_t frames{ m_FrameCount.load(std::memory_order_acquire) };
+	if (frames == 0)
+		return 0;
+
+	const std::uint64_t back{ std::min<std::uint64_t>({ frameCount, frames, framesKept }) };
+	return m_FrameStarts[(frames - std::max<std::uint64_t>(back, 1)) % framesKept].load(std::memory_order_relaxed);
+}
+
+std::vector<ThreadCapture> CpuProfiler::Capture(std::uint64_t since) const
+{
+	std::vector<ThreadCapture> captures;
+
+	std::lock_guard lock{ m_RingsMutex };
+	captures.reserve(m_Rings.size());
+	for (const std::unique_ptr<ThreadRing>& ring : m_Rings)
+	{
+		ThreadCapture& capture = captures.emplace_back();
+		capture.threadId = ring->threadId;
+		capture.threadName = ring->threadName;
+
+		const std::uint64_t head{ ring->head.load(std::memory_order_acquire) };
+		const std::uint64_t first{ head > eventsPerThread ? head - eventsPerThread : 0 };
+		for (std::uint64_t i = first; i < head; ++i)
+			capture.events.push_back(ring->events[i % eventsPerThread]);
+
+		// Entries the owner lapped while they were being copied are unreliable, and so is the
+		// slot of headAfter, which the owner may be writing before it publishes the next head
+		const std::uint64_t headAfter{ ring->head.load(std::memory_order_acquire) };
+		const std::uint64_t firstValid{ headAfter >= eventsPerThread ? headAfter - eventsPerThread + 1 : 0 };
+		if (firstValid > first)
+			capture.events.erase(capture.events.begin(), capture.events.begin() + static_cast<std::ptrdiff_t>(std::min(firstValid, head) - first));
+
+		std::erase_if(capture.events, [since](const ProfileEvent& event) { return event.begin < since; });
+	}
+
+	return captures;
+}
+
+std::vector<ProfileMarker> CpuProfiler::Markers(std::uint64_t since) const
+{
+	std::lock_guard lock{ m_MarkersMutex };
+
+	// Oldest first
+	std::vector<ProfileMarker> markers;
+	const std::size_t first{ m_MarkerCount > markersKept ? m_MarkerCount - markersKept : 0 };
+	for (std::size_t i = first; i < m_MarkerCount; ++i)
+	{
+		const ProfileMarker& marker = m_Markers[i % markersKept];
+		if (marker.time >= since)
+			markers.push_back(marker);
+	}
+
+	return markers;
+}
+
+std::vector<ZoneSummary> CpuProfiler::SummarizeZones(std::uint64_t since) const
+{
+	std::vector<ZoneSummary> zones;
+	for (const ThreadCapture& capture : Capture(since))
+	{
+		for (const ProfileEvent& event : capture.events)
+		{
+			auto found = std::find_if(zones.begin(), zones.end(), [&event](const ZoneSummary& zone)
+			{
+				return std::string_view{ zone.name } == event.name;
+			});
+
+			if (found == zones.end())
+				found = zones.insert(zones.end(), { event.name });
+
+			++found->calls;
+			found->nanoseconds += event.end - event.begin;
+			found->counts += event.counts;
+		}
+	}
+
+	std::sort(zones.begin(), zones.end(), [](const ZoneSummary& a, const ZoneSummary& b) { return a.nanoseconds > b.nanoseconds; });
+	return zones;
+}
+
+void CpuProfiler::WriteTrace(TraceWriter& writer, std::uint64_t since) const
+{
+	for (const ThreadCapture& capture : Capture(since))
+	{
+		writer.ThreadName(capture.threadId, capture.threadName.empty() ? std::format("Thread {}", capture.threadId) : capture.threadName);
+		for (const ProfileEvent& event : capture.events)
+		{
+			if (event.counts.instructions == 0 && event.counts.cycles == 0)
+			{
+				writer.Complete(event.name, capture.threadId, event.begin, event.end);
+				continue;
+			}
+
+			writer.Complete(event.name, capture.threadId, event.begin, event.end, std::format(
+				R"({{"instructions":{},"cycles":{},"cacheMisses":{},"branchMisses":{},"ipc":{:.3f}}})",
+				event.counts.instructions, event.counts.cycles, event.counts.cacheMisses, event.counts.branchMisses,
+				event.counts.InstructionsPerCycle()));
+		}
+	}
+
+	for (const ProfileMarker& marker : Markers(since))
+		writer.Instant(marker.category, marker.threadId, marker.time, false, marker.detail);
+
+	// Frame boundaries across every track
+	const std::uint64_t frames{ m_FrameCount.load(std::memory_order_acquire) };
+	for (std::uint64_t frame = frames - std::min<std::uint64_t>(frames, framesKept); frame < frames; ++frame)
+	{
+		const std::uint64_t start{ m_FrameStarts[frame % framesKept].load(std::memory_order_relaxed) };
+		if (start >= since)
+			writer.Instant(std::format("Frame {}", frame), 0, start, true);
+	}
+}
+
+void CpuProfiler::WriteChromeTrace(const std::string& path, std::size_t frameCount) const
+{
+	const std::uint64_t since{ FrameStart(frameCount) };
+
+	TraceWriter writer{ path, since };
+	WriteTrace(writer, since);
+	writer.Finish();
+}
+
+std::uint64_t CpuProfiler::Now() noexcept
+{
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::string GameEngine::FormatZoneSummary(const std::vector<ZoneSummary>& zones)
+{
+	std::string table{ std::format("{:<28}{:>8}{:>12}{:>14}{:>8}{:>12}{:>12}\n",
+		"zone", "calls", "total ms", "instructions", "IPC", "cache MPKI", "branch MPKI") };
+
+	for (const ZoneSummary& zone : zones)
+	{
+		table += std::format("{:<28}{:>8}{:>12.3f}{:>14}{:>8.2f}{:>12.2f}{:>12.2f}\n",
+			zone.name, zone.calls, static_cast<double>(zone.nanoseconds) / 1.0e6, zone.counts.instructions,
+			zone.counts.InstructionsPerCycle(), zone.counts.CacheMissesPerKiloInstruction(), zone.counts.BranchMissesPerKiloInstruction());
+	}
+
+	return table;
+}
+
+CpuProfiler::ThreadRing& CpuProfiler::CurrentRing()
+{
+	static thread_local ThreadRing* ring{};
+	if (ring == nullptr)
+	{
+		auto created = std::make_unique<ThreadRing>();
+		ring = created.get();
+
+		std::lock_guard lock{ m_RingsMutex };
+		ring->threadId = static_cast<std::uint32_t>(m_Rings.size());
+		m_Rings.push_back(std::move(created));
+	}
+
+	return *ring;
+}
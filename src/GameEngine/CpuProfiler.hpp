@@ -0,0 +1,168 @@
+#pragma once
+#include "PerfCounters.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Defining GAMEENGINE_PROFILER_DISABLED (release-minimal builds) turns every
+// PROFILE_* macro into nothing, no zone code is left in the binary. The arguments
+// still go through an unevaluated sizeof, so variables used only there stay used
+#ifndef GAMEENGINE_PROFILER_DISABLED
+	#define GAMEENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+	#define GAMEENGINE_PROFILE_CONCAT(a, b) GAMEENGINE_PROFILE_CONCAT_IMPL(a, b)
+
+	// Times the rest of the enclosing block, name has to be a string literal
+	#define PROFILE_ZONE(name) ::GameEngine::CpuZone GAMEENGINE_PROFILE_CONCAT(profileZone, __LINE__){ name }
+	#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+
+	// Marks the start of a new frame, call once per frame on the main thread
+	#define PROFILE_FRAME() ::GameEngine::CpuProfiler::Instance().MarkFrame()
+
+	// Names the calling thread in the exported traces
+	#define PROFILE_THREAD(name) ::GameEngine::CpuProfiler::Instance().NameThread(name)
+
+	// Rare notable event (asset load, shader compile) with a detail string, e.g. the file path
+	#define PROFILE_MARKER(category, detail) ::GameEngine::CpuProfiler::Instance().Marker(category, detail)
+#else
+	#define PROFILE_ZONE(name) ((void)0)
+	#define PROFILE_FUNCTION() ((void)0)
+	#define PROFILE_FRAME() ((void)0)
+	#define PROFILE_THREAD(name) ((void)sizeof(name))
+	#define PROFILE_MARKER(category, detail) ((void)sizeof(category), (void)sizeof(detail))
+#endif
+
+namespace GameEngine
+{
+	class TraceWriter;
+
+	// Finished zone, times are steady_clock nanoseconds
+	struct ProfileEvent
+	{
+		const char*		name{};
+		std::uint64_t	begin{};
+		std::uint64_t	end{};
+		std::uint32_t	depth{};
+		PerfCounts		counts{};		// hardware counters spent in the zone, zero unless PerfCounters are enabled
+	};
+
+	// Totals of every zone with the same name, counters include the nested zones
+	struct ZoneSummary
+	{
+		const char*		name{};
+		std::size_t		calls{};
+		std::uint64_t	nanoseconds{};
+		PerfCounts		counts{};
+	};
+
+	struct ProfileMarker
+	{
+		std::uint64_t	time{};
+		std::uint32_t	threadId{};
+		const char*		category{};
+		std::string		detail;
+	};
+
+	// Copy of the events of one thread
+	struct ThreadCapture
+	{
+		std::uint32_t				threadId{};		// in registration order, the main loop is usually 0
+		std::string					threadName;
+		std::vector<ProfileEvent>	events;			// in the order the zones ended
+	};
+
+	// Hierarchical CPU profiler. Each thread records its zones into its own ring buffer
+	// without locks, only its first zone registers the ring. Old events are overwritten,
+	// so a capture holds the last frames only
+	class CpuProfiler
+	{
+	public:
+		static constexpr std::size_t eventsPerThread{ 1 << 16 };
+		static constexpr std::size_t framesKept{ 512 };
+		static constexpr std::size_t markersKept{ 256 };
+
+		static CpuProfiler& Instance();
+
+		CpuProfiler(const CpuProfiler&) = delete;
+		CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+
+		//				[UTILITY]
+
+		void MarkFrame() noexcept;
+		void NameThread(const std::string& name);
+
+		// Appends a finished zone of the calling thread
+		void Record(const ProfileEvent& event) noexcept;
+
+		// Markers are rare, they take a lock
+		void Marker(const char* category, std::string detail);
+
+		// Start time of the frameCount-th frame from the end, the oldest kept one when there are fewer
+		std::uint64_t FrameStart(std::size_t frameCount) const noexcept;
+
+		// Events of every thread that began at or after since. Events overwritten
+		// while copying are left out
+		std::vector<ThreadCapture> Capture(std::uint64_t since) const;
+		std::vector<ProfileMarker> Markers(std::uint64_t since) const;
+
+		// Zones of every thread from since onwards grouped by name, the most expensive first
+		std::vector<ZoneSummary> SummarizeZones(std::uint64_t since) const;
+
+		// Thread names, zones, markers and frame starts from since onwards
+		void WriteTrace(TraceWriter& writer, std::uint64_t since) const;
+
+		// Writes the last frameCount frames in Chrome trace_event JSON (chrome://tracing, Perfetto)
+		// Exceptions: [runtime_error]
+		void WriteChromeTrace(const std::string& path, std::size_t frameCount) const;
+
+		static std::uint64_t Now() noexcept;
+
+	private:
+		struct ThreadRing
+		{
+			std::array<ProfileEvent, eventsPerThread> events{};
+			std::atomic<std::uint64_t> head{};		// total events written
+			std::uint32_t threadId{};
+			std::string threadName;
+		};
+
+		mutable std::mutex m_RingsMutex;
+		std::vector<std::unique_ptr<ThreadRing>> m_Rings;	// never shrinks, rings outlive their threads
+
+		std::array<std::atomic<std::uint64_t>, framesKept> m_FrameStarts{};
+		std::atomic<std::uint64_t> m_FrameCount{};
+
+		mutable std::mutex m_MarkersMutex;
+		std::vector<ProfileMarker> m_Markers;		// ring of markersKept
+		std::size_t m_MarkerCount{};
+
+		CpuProfiler() = default;
+
+		ThreadRing& CurrentRing();
+	};
+
+	// Records the time between its construction and destruction, use PROFILE_ZONE
+	class CpuZone
+	{
+	public:
+		explicit CpuZone(const char* name) noexcept;
+		~CpuZone();
+
+		CpuZone(const CpuZone&) = delete;
+		CpuZone& operator=(const CpuZone&) = delete;
+
+	private:
+		const char* m_Name;
+		std::uint64_t m_Begin;
+		std::uint32_t m_Depth;
+		PerfCounts m_Counts;
+	};
+
+	// Table of the zone totals with IPC and misses per thousand instructions
+	std::string FormatZoneSummary(const std::vector<ZoneSummary>& zones);
+}
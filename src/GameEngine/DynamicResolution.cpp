@@ -0,0 +1,136 @@
+#include "DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace GameEngine;
+
+//						[CONSTRUCTORS]
+
+ResolutionController::ResolutionController(const DynamicResolutionSettings& settings)
+	: m_Settings{ settings }
+{
+	m_Settings.minScale = std::clamp(m_Settings.minScale, 0.1f, 1.0f);
+	m_Settings.maxScale = std::clamp(m_Settings.maxScale, m_Settings.minScale, 1.0f);
+	m_Settings.scaleStep = std::max(m_Settings.scaleStep, 0.01f);
+	m_Scale = m_Settings.maxScale;
+}
+
+DynamicResolution::DynamicResolution(int windowWidth, int windowHeight, const DynamicResolutionSettings& settings)
+	: m_Controller{ settings },
+	m_Target{ std::max(windowWidth, 1), std::max(windowHeight, 1), GL_LINEAR },
+	m_WindowWidth{ windowWidth }, m_WindowHeight{ windowHeight }
+{
+}
+
+
+//						[GETTERS]
+
+int DynamicResolution::RenderWidth() const noexcept
+{
+	return std::max(static_cast<int>(std::lround(m_WindowWidth * m_Controller.Scale())), 1);
+}
+
+int DynamicResolution::RenderHeight() const noexcept
+{
+	return std::max(static_cast<int>(std::lround(m_WindowHeight * m_Controller.Scale())), 1);
+}
+
+
+//						[UTILITY]
+
+bool ResolutionController::Update(double gpuMs, double cpuMs)
+{
+	const double weight{ m_Settings.smoothing };
+	m_GpuMs = m_GpuMs < 0.0 ? gpuMs : m_GpuMs + (gpuMs - m_GpuMs) * weight;
+	m_CpuMs = m_CpuMs < 0.0 ? cpuMs : m_CpuMs + (cpuMs - m_CpuMs) * weight;
+
+	const double budget{ m_Settings.frameBudgetMs };
+	const float nextScale{ std::min(m_Scale + m_Settings.scaleStep, m_Settings.maxScale) };
+	const double predictedGpuMs{ m_GpuMs * (nextScale * nextScale) / (m_Scale * m_Scale) };
+
+	if (m_GpuMs > budget * m_Settings.lowerThreshold)
+	{
+		++m_OverBudget;
+		m_UnderBudget = 0;
+	}
+	else if (nextScale > m_Scale && predictedGpuMs < budget * m_Settings.raiseThreshold && m_CpuMs < budget)
+	{
+		++m_UnderBudget;
+		m_OverBudget = 0;
+	}
+	else
+	{
+		m_OverBudget = 0;
+		m_UnderBudget = 0;
+	}
+
+	// The GPU timings lag behind, give the last change time to show up in them
+	if (m_Cooldown > 0)
+	{
+		--m_Cooldown;
+		return false;
+	}
+
+	if (m_OverBudget >= m_Settings.framesToLower && m_Scale > m_Settings.minScale)
+	{
+		// GPU time follows the pixel count, aim between the two thresholds
+		const double target{ budget * (m_Settings.lowerThreshold + m_Settings.raiseThreshold) * 0.5 };
+		const float wanted{ m_Scale * static_cast<float>(std::sqrt(target / m_GpuMs)) };
+		const float snapped{ std::floor(wanted / m_Settings.scaleStep) * m_Settings.scaleStep };
+
+		ChangeScale(std::min(snapped, m_Scale - m_Settings.scaleStep));
+		return true;
+	}
+
+	if (m_UnderBudget >= m_Settings.framesToRaise)
+	{
+		ChangeScale(nextScale);
+		return true;
+	}
+
+	return false;
+}
+
+void ResolutionController::ChangeScale(float newScale)
+{
+	newScale = std::clamp(newScale, m_Settings.minScale, m_Settings.maxScale);
+
+	// Expected time at the new scale, so the average does not have to relearn it
+	m_GpuMs *= (newScale * newScale) / (m_Scale * m_Scale);
+	m_Scale = newScale;
+	m_OverBudget = 0;
+	m_UnderBudget = 0;
+	m_Cooldown = m_Settings.framesToLower * 2;
+}
+
+void DynamicResolution::WindowResized(int windowWidth, int windowHeight)
+{
+	m_WindowWidth = windowWidth;
+	m_WindowHeight = windowHeight;
+	m_ResizePending = true;
+}
+
+void DynamicResolution::Begin()
+{
+	if (m_ResizePending && m_WindowWidth > 0 && m_WindowHeight > 0)
+	{
+		m_Target.Resize(m_WindowWidth, m_WindowHeight);
+		m_ResizePending = false;
+	}
+
+	m_GpuTimer.Begin();
+	m_Target.Bind();
+	glViewport(0, 0, RenderWidth(), RenderHeight());
+}
+
+void DynamicResolution::Present(double cpuMs)
+{
+	m_GpuTimer.End();
+
+	glViewport(0, 0, m_WindowWidth, m_WindowHeight);
+	m_Target.BlitToScreen(RenderWidth(), RenderHeight(), 0, 0, m_WindowWidth, m_WindowHeight, GL_LINEAR);
+
+	if (const std::optional<double> gpuMs = m_GpuTimer.Poll())
+		m_Controller.Update(*gpuMs, cpuMs);
+}
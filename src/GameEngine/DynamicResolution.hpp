@@ -0,0 +1,98 @@
+#pragma once
+#include "RenderTarget.hpp"
+#include "GpuTimer.hpp"
+
+namespace GameEngine
+{
+	struct DynamicResolutionSettings
+	{
+		double	frameBudgetMs{ 1000.0 / 60.0 };
+		float	minScale{ 0.5f };			// of the window size, per axis
+		float	maxScale{ 1.0f };
+		float	scaleStep{ 0.05f };			// scales are multiples of it
+		double	lowerThreshold{ 0.95 };		// GPU time above this part of the budget lowers the scale
+		double	raiseThreshold{ 0.75 };		// predicted GPU time at the next step below it raises the scale
+		int		framesToLower{ 4 };
+		int		framesToRaise{ 60 };		// raising is slower than lowering, so the scale does not oscillate
+		double	smoothing{ 0.2 };			// weight of the newest sample in the moving averages
+	};
+
+	// Picks the render scale from the measured frame times. The scale drops quickly when the
+	// GPU goes over budget and climbs back one step at a time once there is clear headroom.
+	// CPU time only blocks raising: a CPU bound frame does not get faster with fewer pixels
+	class ResolutionController
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		explicit ResolutionController(const DynamicResolutionSettings& settings = {});
+
+
+		//				[GETTERS]
+
+		float Scale() const noexcept { return m_Scale; }
+		double GpuMs() const noexcept { return m_GpuMs; }
+		double CpuMs() const noexcept { return m_CpuMs; }
+		const DynamicResolutionSettings& Settings() const noexcept { return m_Settings; }
+
+
+		//				[UTILITY]
+
+		// Feeds the timings of one frame, returns true when the scale changed
+		bool Update(double gpuMs, double cpuMs);
+
+	private:
+		DynamicResolutionSettings m_Settings;
+		float m_Scale{};
+		double m_GpuMs{ -1.0 };		// moving averages, negative until the first sample
+		double m_CpuMs{ -1.0 };
+		int m_OverBudget{};
+		int m_UnderBudget{};
+		int m_Cooldown{};
+
+		void ChangeScale(float newScale);
+	};
+
+
+	// Scene target rendered at a variable part of the window resolution and stretched
+	// to the window. The target is allocated at the maximum scale and only a part of it
+	// is drawn into, so changing the scale never reallocates anything
+	class DynamicResolution
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		DynamicResolution(int windowWidth, int windowHeight, const DynamicResolutionSettings& settings = {});
+
+
+		//				[GETTERS]
+
+		float Scale() const noexcept { return m_Controller.Scale(); }
+		int RenderWidth() const noexcept;
+		int RenderHeight() const noexcept;
+		const ResolutionController& Controller() const noexcept { return m_Controller; }
+
+
+		//				[UTILITY]
+
+		// Reallocation happens in the next Begin()
+		void WindowResized(int windowWidth, int windowHeight);
+
+		// Binds the target with the viewport of the current scale and starts the GPU timer
+		// Exceptions: [runtime_error]
+		void Begin();
+
+		// Stops the GPU timer, stretches the scene to the window and feeds the controller.
+		// cpuMs is the CPU time of the frame without the wait for the swap
+		void Present(double cpuMs);
+
+	private:
+		ResolutionController m_Controller;
+		RenderTarget m_Target;
+		GpuTimer m_GpuTimer;
+		int m_WindowWidth{};
+		int m_WindowHeight{};
+		bool m_ResizePending{};
+	};
+}
@@ -0,0 +1,148 @@
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+// Nearest-rank percentile of sorted values
+static double Percentile(const std::vector<double>& sorted, double percent)
+{
+	const double rank{ std::ceil(percent / 100.0 * static_cast<double>(sorted.size())) };
+	const std::size_t index{ static_cast<std::size_t>(std::max(rank, 1.0)) - 1 };
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+
+//						[CONSTRUCTORS]
+
+FrameStats::FrameStats(double budgetMs, std::size_t windowSize)
+	: m_BudgetMs{ budgetMs }
+	, m_WindowSize{ std::max<std::size_t>(windowSize, 1) }
+{
+	m_Window.reserve(m_WindowSize);
+}
+
+
+//						[GETTERS]
+
+std::vector<double> FrameStats::Recent() const
+{
+	// Until the window fills up m_Next equals its size and the rotation does nothing
+	std::vector<double> recent(m_Window.size());
+	std::rotate_copy(m_Window.begin(), m_Window.begin() + static_cast<std::ptrdiff_t>(m_Next % std::max<std::size_t>(m_Window.size(), 1)), m_Window.end(), recent.begin());
+	return recent;
+}
+
+FrameStatsSummary FrameStats::Summary() const
+{
+	FrameStatsSummary summary{};
+	if (m_Window.empty())
+		return summary;
+
+	std::vector<double> sorted{ m_Window };
+	std::sort(sorted.begin(), sorted.end());
+
+	summary.frames = sorted.size();
+	summary.minMs = sorted.front();
+	summary.maxMs = sorted.back();
+	summary.averageMs = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+	summary.p50Ms = Percentile(sorted, 50.0);
+	summary.p95Ms = Percentile(sorted, 95.0);
+	summary.p99Ms = Percentile(sorted, 99.0);
+	summary.p999Ms = Percentile(sorted, 99.9);
+
+	const std::size_t slowest{ std::max<std::size_t>(sorted.size() / 100, 1) };
+	const double slowestMs{ std::accumulate(sorted.end() - static_cast<std::ptrdiff_t>(slowest), sorted.end(), 0.0) / static_cast<double>(slowest) };
+	summary.onePercentLowFps = slowestMs > 0.0 ? 1000.0 / slowestMs : 0.0;
+
+	summary.overBudget = static_cast<std::size_t>(std::count_if(sorted.begin(), sorted.end(), [this](double ms) { return ms > m_BudgetMs; }));
+	summary.hitches = static_cast<std::size_t>(std::count_if(sorted.begin(), sorted.end(), [this](double ms) { return ms > m_BudgetMs * 2.0; }));
+
+	return summary;
+}
+
+
+//						[UTILITY]
+
+void FrameStats::Record(double frameMs)
+{
+	if (m_Window.size() < m_WindowSize)
+		m_Window.push_back(frameMs);
+	else
+		m_Window[m_Next] = frameMs;
+	m_Next = (m_Next + 1) % m_WindowSize;
+
+	++m_TotalFrames;
+	if (frameMs > m_BudgetMs)
+		++m_TotalOverBudget;
+	if (frameMs > m_BudgetMs * 2.0)
+		++m_TotalHitches;
+
+	++m_Histogram[BucketOf(frameMs)];
+}
+
+void FrameStats::Reset()
+{
+	m_Window.clear();
+	m_Next = 0;
+	m_TotalFrames = 0;
+	m_TotalOverBudget = 0;
+	m_TotalHitches = 0;
+	m_Histogram.fill(0);
+}
+
+double FrameStats::BucketStartMs(std::size_t bucket) noexcept
+{
+	if (bucket == 0)
+		return 0.0;
+
+	return firstBucketMs * std::exp2(static_cast<double>(bucket - 1) / bucketsPerOctave);
+}
+
+std::size_t FrameStats::BucketOf(double frameMs) noexcept
+{
+	if (!(frameMs >= firstBucketMs))
+		return 0;
+
+	const double bucket{ std::floor(std::log2(frameMs / firstBucketMs) * bucketsPerOctave) + 1.0 };
+	return std::min(static_cast<std::size_t>(bucket), bucketCount - 1);
+}
+
+std::string FrameStats::Report() const
+{
+	const FrameStatsSummary summary{ Summary() };
+
+	std::string report{ std::format("Frame time statistics, budget {:.2f} ms\n", m_BudgetMs) };
+	report += std::format("Last {} frames: min {:.2f}, avg {:.2f}, max {:.2f} ms\n", summary.frames, summary.minMs, summary.averageMs, summary.maxMs);
+	report += std::format("  p50 {:.2f}, p95 {:.2f}, p99 {:.2f}, p99.9 {:.2f} ms\n", summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.p999Ms);
+	report += std::format("  1% low {:.1f} FPS, over budget {}, hitches {}\n", summary.onePercentLowFps, summary.overBudget, summary.hitches);
+	report += std::format("Session: {} frames, over budget {}, hitches (> 2x budget) {}\n", m_TotalFrames, m_TotalOverBudget, m_TotalHitches);
+	if (m_TimeToFirstFrameMs > 0.0)
+		report += std::format("Time to first frame: {:.2f} ms\n", m_TimeToFirstFrameMs);
+
+	report += "Histogram:\n";
+	for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+	{
+		if (m_Histogram[bucket] == 0)
+			continue;
+
+		const std::string end{ bucket + 1 < bucketCount ? std::format("{:.2f}", BucketStartMs(bucket + 1)) : std::string{ "inf" } };
+		report += std::format("  [{:>8.2f}; {:>8}) ms {:>10}\n", BucketStartMs(bucket), end, m_Histogram[bucket]);
+	}
+
+	return report;
+}
+
+void FrameStats::WriteReport(const std::string& path) const
+{
+	std::ofstream file{ path };
+	if (!file)
+		throw std::runtime_error("FrameStats.WriteReport error: can't open " + path);
+
+	file << Report();
+}
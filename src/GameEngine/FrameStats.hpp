@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// Statistics of the frames in the rolling window
+	struct FrameStatsSummary
+	{
+		std::size_t	frames{};
+		double		minMs{};
+		double		averageMs{};
+		double		maxMs{};
+		double		p50Ms{};
+		double		p95Ms{};
+		double		p99Ms{};
+		double		p999Ms{};
+		double		onePercentLowFps{};		// average FPS of the slowest 1% of the frames
+		std::size_t	overBudget{};			// frames longer than the budget
+		std::size_t	hitches{};				// frames longer than twice the budget
+	};
+
+	// Frame time statistics: a rolling window for the percentiles and a log-bucketed
+	// histogram plus over-budget counters for the whole session
+	class FrameStats
+	{
+	public:
+		// 4 buckets per octave from 0.25 ms, the last one collects everything from 4.1 s up
+		static constexpr std::size_t bucketCount{ 58 };
+		static constexpr double firstBucketMs{ 0.25 };
+		static constexpr double bucketsPerOctave{ 4.0 };
+
+
+		//				[CONSTRUCTORS]
+
+		explicit FrameStats(double budgetMs = 1000.0 / 60.0, std::size_t windowSize = 1000);
+
+
+		//				[GETTERS]
+
+		double BudgetMs() const noexcept { return m_BudgetMs; }
+		double TimeToFirstFrameMs() const noexcept { return m_TimeToFirstFrameMs; }
+		std::size_t TotalFrames() const noexcept { return m_TotalFrames; }
+		std::size_t TotalOverBudget() const noexcept { return m_TotalOverBudget; }
+		std::size_t TotalHitches() const noexcept { return m_TotalHitches; }
+		const std::array<std::uint64_t, bucketCount>& Histogram() const noexcept { return m_Histogram; }
+
+		// Frame times of the window, oldest first
+		std::vector<double> Recent() const;
+
+		// Percentiles of the window, sorts a copy of it
+		FrameStatsSummary Summary() const;
+
+
+		//				[SETTERS]
+
+		// Shown in the report next to the frame times (see StartupTimeline)
+		void TimeToFirstFrameMs(double ms) noexcept { m_TimeToFirstFrameMs = ms; }
+
+
+		//				[UTILITY]
+
+		void Record(double frameMs);
+		void Reset();
+
+		// Lower edge of a histogram bucket
+		static double BucketStartMs(std::size_t bucket) noexcept;
+		static std::size_t BucketOf(double frameMs) noexcept;
+
+		// Human readable report of the window and the session histogram
+		std::string Report() const;
+
+		// Exceptions: [runtime_error]
+		void WriteReport(const std::string& path) const;
+
+	private:
+		double m_BudgetMs{};
+		double m_TimeToFirstFrameMs{};
+		std::size_t m_WindowSize{};
+		std::vector<double> m_Window;		// ring of the last m_WindowSize frame times
+		std::size_t m_Next{};
+		std::size_t m_TotalFrames{};
+		std::size_t m_TotalOverBudget{};
+		std::size_t m_TotalHitches{};
+		std::array<std::uint64_t, bucketCount> m_Histogram{};
+	};
+}
@@ -0,0 +1,206 @@
+#include "GpuProfiler.hpp"
+#include "CpuProfiler.hpp"
+
+#include <algorithm>
+
+using namespace GameEngine;
+
+static constexpr double averageWeight{ 0.1 };
+
+//						[CONSTRUCTORS]
+
+GpuProfiler::GpuProfiler(std::size_t framesInFlight, std::size_t maxScopesPerFrame)
+	: m_Slots(std::max<std::size_t>(framesInFlight, 2))
+{
+	for (FrameSlot& slot : m_Slots)
+	{
+		slot.queries.resize(2 + maxScopesPerFrame * 2);
+		glGenQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+		slot.scopes.reserve(maxScopesPerFrame);
+	}
+}
+
+GpuProfiler::~GpuProfiler()
+{
+	for (FrameSlot& slot : m_Slots)
+		glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+}
+
+
+//						[UTILITY]
+
+void GpuProfiler::BeginFrame()
+{
+	FrameSlot& slot = m_Slots[m_Current];
+	if (slot.pending && !Collect(slot))
+	{
+		slot.pending = false;
+		++m_Dropped;
+	}
+
+	slot.scopes.clear();
+	slot.usedQueries = 2;
+	slot.cpuTime = CpuProfiler::Now();
+	m_OpenScopes.clear();
+	m_InFrame = true;
+
+	glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+}
+
+void GpuProfiler::EndFrame()
+{
+	if (!m_InFrame)
+		return;
+
+	// Scopes left open end with the frame
+	while (!m_OpenScopes.empty())
+		EndScope();
+
+	FrameSlot& slot = m_Slots[m_Current];
+	glQueryCounter(slot.queries[1], GL_TIMESTAMP);
+	slot.pending = true;
+	m_InFrame = false;
+	m_Current = (m_Current + 1) % m_Slots.size();
+
+	// Oldest first, frames finish in order so the first unavailable one ends the search
+	for (std::size_t i = 0; i < m_Slots.size(); ++i)
+	{
+		FrameSlot& finished = m_Slots[(m_Current + i) % m_Slots.size()];
+		if (finished.pending && !Collect(finished))
+			break;
+	}
+}
+
+void GpuProfiler::BeginScope(const char* name)
+{
+	FrameSlot& slot = m_Slots[m_Current];
+	if (!m_InFrame || slot.usedQueries + 2 > slot.queries.size())
+	{
+		// Keeps EndScope() balanced
+		m_OpenScopes.push_back(SIZE_MAX);
+		return;
+	}
+
+	ScopeRecord scope{ name, static_cast<int>(m_OpenScopes.size()), slot.usedQueries, slot.usedQueries + 1 };
+	slot.usedQueries += 2;
+
+	glQueryCounter(slot.queries[scope.beginQuery], GL_TIMESTAMP);
+	m_OpenScopes.push_back(slot.scopes.size());
+	slot.scopes.push_back(scope);
+}
+
+void GpuProfiler::EndScope()
+{
+	if (m_OpenScopes.empty())
+		return;
+
+	const std::size_t index{ m_OpenScopes.back() };
+	m_OpenScopes.pop_back();
+	if (index == SIZE_MAX)
+		return;
+
+	FrameSlot& slot = m_Slots[m_Current];
+	glQueryCounter(slot.queries[slot.scopes[index].endQuery], GL_TIMESTAMP);
+}
+
+std::vector<GpuFrameRecord> GpuProfiler::History(std::uint64_t since) const
+{
+	std::vector<GpuFrameRecord> history;
+	const std::size_t first{ m_HistoryCount > historyKept ? m_HistoryCount - historyKept : 0 };
+	for (std::size_t i = first; i < m_HistoryCount; ++i)
+	{
+		const GpuFrameRecord& record = m_History[i % historyKept];
+		if (record.cpuTime >= since)
+			history.push_back(record);
+	}
+
+	return history;
+}
+
+void GpuProfiler::ResetStats() noexcept
+{
+	// The moving averages keep going, they are not per-capture values
+	m_Frame = { m_Frame.name, m_Frame.depth, m_Frame.lastMs, m_Frame.averageMs };
+	for (GpuPassTiming& pass : m_Passes)
+		pass = { pass.name, pass.depth, pass.lastMs, pass.averageMs };
+	m_Dropped = 0;
+}
+
+bool GpuProfiler::Collect(FrameSlot& slot)
+{
+	GLint available{};
+	glGetQueryObjectiv(slot.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (available == GL_FALSE)
+		return false;
+
+	// The frame end query is the last one issued, everything before it is available too
+	auto timestamp = [&slot](std::size_t query)
+	{
+		GLuint64 nanoseconds{};
+		glGetQueryObjectui64v(slot.queries[query], GL_QUERY_RESULT, &nanoseconds);
+		return nanoseconds;
+	};
+
+	auto milliseconds = [&timestamp](std::size_t begin, std::size_t end)
+	{
+		const GLuint64 first{ timestamp(begin) };
+		const GLuint64 last{ timestamp(end) };
+		return last > first ? static_cast<double>(last - first) / 1.0e6 : 0.0;
+	};
+
+	if (m_History.size() < historyKept)
+		m_History.resize(historyKept);
+	GpuFrameRecord& record = m_History[m_HistoryCount % historyKept];
+	++m_HistoryCount;
+
+	record.cpuTime = slot.cpuTime;
+	record.frameMs = milliseconds(0, 1);
+	record.scopes.clear();
+	Record(m_Frame, record.frameMs);
+
+	// A scope used several times in a frame is reported as the sum. Passes not opened
+	// in the frame (e.g. an overlay that is turned off) get no sample, not a 0 ms one
+	m_FramePassMs.assign(m_Passes.size(), -1.0);
+	for (const ScopeRecord& scope : slot.scopes)
+	{
+		const double ms{ milliseconds(scope.beginQuery, scope.endQuery) };
+		const std::size_t pass{ static_cast<std::size_t>(&PassTiming(scope.name, scope.depth) - m_Passes.data()) };
+		if (pass >= m_FramePassMs.size())
+			m_FramePassMs.resize(pass + 1, -1.0);
+
+		m_FramePassMs[pass] = std::max(m_FramePassMs[pass], 0.0) + ms;
+		record.scopes.push_back({ scope.name, ms });
+	}
+
+	for (std::size_t pass = 0; pass < m_FramePassMs.size(); ++pass)
+	{
+		if (m_FramePassMs[pass] >= 0.0)
+			Record(m_Passes[pass], m_FramePassMs[pass]);
+	}
+
+	slot.pending = false;
+	return true;
+}
+
+void GpuProfiler::Record(GpuPassTiming& timing, double ms) noexcept
+{
+	timing.lastMs = ms;
+	timing.averageMs = timing.averageMs == 0.0 ? ms : timing.averageMs + (ms - timing.averageMs) * averageWeight;
+	timing.maxMs = std::max(timing.maxMs, ms);
+	timing.totalMs += ms;
+	++timing.samples;
+}
+
+GpuPassTiming& GpuProfiler::PassTiming(const char* name, int depth)
+{
+	auto found = std::find_if(m_Passes.begin(), m_Passes.end(), [name](const GpuPassTiming& pass)
+	{
+		return pass.name == name;
+	});
+
+	if (found != m_Passes.end())
+		return *found;
+
+	m_Passes.push_back({ name, depth });
+	return m_Passes.back();
+}
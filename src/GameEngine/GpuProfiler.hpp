@@ -0,0 +1,135 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// Aggregated GPU time of a named scope
+	struct GpuPassTiming
+	{
+		std::string	name;
+		int			depth{};			// nesting level, 0 for top-level scopes
+		double		lastMs{};
+		double		averageMs{};		// exponential moving average
+		double		maxMs{};			// since the last ResetStats()
+		double		totalMs{};			// since the last ResetStats()
+		std::size_t	samples{};
+
+		double MeanMs() const noexcept { return samples > 0 ? totalMs / static_cast<double>(samples) : 0.0; }
+	};
+
+	// GPU times of one collected frame
+	struct GpuFrameRecord
+	{
+		struct ScopeTime
+		{
+			const char*	name{};
+			double		ms{};
+		};
+
+		std::uint64_t			cpuTime{};		// CpuProfiler::Now() at BeginFrame()
+		double					frameMs{};
+		std::vector<ScopeTime>	scopes;
+	};
+
+	// Named GPU scopes measured with GL_TIMESTAMP queries, so they can nest.
+	// Every frame has its own set of queries in a ring of framesInFlight frames and
+	// is read back once its last query is available, reading never stalls the pipeline.
+	// Frames whose results did not arrive before their slot comes around again are dropped
+	class GpuProfiler
+	{
+	public:
+		static constexpr std::size_t historyKept{ 240 };
+
+
+		//				[CONSTRUCTORS]
+
+		explicit GpuProfiler(std::size_t framesInFlight = 4, std::size_t maxScopesPerFrame = 64);
+		~GpuProfiler();
+
+		GpuProfiler(const GpuProfiler&) = delete;
+		GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+
+		// Measures the GPU time between its construction and destruction
+		class Scope
+		{
+		public:
+			Scope(GpuProfiler& profiler, const char* name) : m_Profiler{ profiler } { m_Profiler.BeginScope(name); }
+			~Scope() { m_Profiler.EndScope(); }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			GpuProfiler& m_Profiler;
+		};
+
+
+		//				[GETTERS]
+
+		// Scopes in the order they were first seen, latest results are a few frames old
+		std::span<const GpuPassTiming> Passes() const noexcept { return m_Passes; }
+
+		// GPU time between BeginFrame() and EndFrame()
+		const GpuPassTiming& Frame() const noexcept { return m_Frame; }
+
+		std::size_t DroppedFrames() const noexcept { return m_Dropped; }
+
+		// Collected frames that began on the CPU at or after since, oldest first
+		std::vector<GpuFrameRecord> History(std::uint64_t since) const;
+
+
+		//				[UTILITY]
+
+		void BeginFrame();
+
+		// Also collects every finished frame
+		void EndFrame();
+
+		// Scopes past maxScopesPerFrame in a frame are ignored
+		void BeginScope(const char* name);
+		void EndScope();
+
+		void ResetStats() noexcept;
+
+	private:
+		struct ScopeRecord
+		{
+			const char*		name{};
+			int				depth{};
+			std::size_t		beginQuery{};	// indices into FrameSlot::queries
+			std::size_t		endQuery{};
+		};
+
+		struct FrameSlot
+		{
+			std::vector<unsigned int> queries;		// [0] frame begin, [1] frame end, then the scopes
+			std::vector<ScopeRecord> scopes;
+			std::size_t usedQueries{};
+			std::uint64_t cpuTime{};
+			bool pending{};
+		};
+
+		std::vector<FrameSlot> m_Slots;
+		std::size_t m_Current{};
+		std::vector<std::size_t> m_OpenScopes;		// indices into the current slot's scopes
+		bool m_InFrame{};
+
+		std::vector<GpuPassTiming> m_Passes;
+		std::vector<double> m_FramePassMs;			// per pass while collecting a frame, negative when not opened
+		GpuPassTiming m_Frame{ "frame" };
+		std::size_t m_Dropped{};
+
+		std::vector<GpuFrameRecord> m_History;		// ring of historyKept
+		std::size_t m_HistoryCount{};
+
+		// Reads a finished frame, returns false when its results are not available yet
+		bool Collect(FrameSlot& slot);
+		void Record(GpuPassTiming& timing, double ms) noexcept;
+		GpuPassTiming& PassTiming(const char* name, int depth);
+	};
+}
@@ -0,0 +1,68 @@
+#include "GpuTimer.hpp"
+
+#include <algorithm>
+
+using namespace GameEngine;
+
+//						[CONSTRUCTORS]
+
+GpuTimer::GpuTimer(std::size_t latency)
+	: m_Slots(std::max<std::size_t>(latency, 2))
+{
+	for (Slot& slot : m_Slots)
+		glGenQueries(1, &slot.query);
+}
+
+GpuTimer::~GpuTimer()
+{
+	for (Slot& slot : m_Slots)
+		glDeleteQueries(1, &slot.query);
+}
+
+
+//						[UTILITY]
+
+void GpuTimer::Begin()
+{
+	if (m_Running)
+		return;
+
+	glBeginQuery(GL_TIME_ELAPSED, m_Slots[m_Next].query);
+	m_Running = true;
+}
+
+void GpuTimer::End()
+{
+	if (!m_Running)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	m_Slots[m_Next].pending = true;
+	m_Next = (m_Next + 1) % m_Slots.size();
+	m_Running = false;
+}
+
+std::optional<double> GpuTimer::Poll()
+{
+	std::optional<double> newest;
+
+	// Oldest first, so the last result read is the newest one
+	for (std::size_t i = 0; i < m_Slots.size(); ++i)
+	{
+		Slot& slot = m_Slots[(m_Next + i) % m_Slots.size()];
+		if (!slot.pending)
+			continue;
+
+		GLint available{};
+		glGetQueryObjectiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == GL_FALSE)
+			continue;
+
+		GLuint64 nanoseconds{};
+		glGetQueryObjectui64v(slot.query, GL_QUERY_RESULT, &nanoseconds);
+		slot.pending = false;
+		newest = static_cast<double>(nanoseconds) / 1.0e6;
+	}
+
+	return newest;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <glad/glad.h>
+#include <optional>
+#include <vector>
+
+namespace GameEngine
+{
+	// Measures the GPU time between Begin() and End() with GL_TIME_ELAPSED queries.
+	// Results arrive a few frames late, the queries are kept in a ring so reading
+	// them never stalls the pipeline. Only one timer can be running at a time
+	class GpuTimer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		explicit GpuTimer(std::size_t latency = 4);
+		~GpuTimer();
+
+		GpuTimer(const GpuTimer&) = delete;
+		GpuTimer& operator=(const GpuTimer&) = delete;
+
+
+		//				[UTILITY]
+
+		// A slot whose result has not arrived yet is dropped and reused
+		void Begin();
+		void End();
+
+		// Collects the finished queries, returns the newest result in milliseconds
+		std::optional<double> Poll();
+
+	private:
+		struct Slot
+		{
+			unsigned int query{};
+			bool pending{};
+		};
+
+		std::vector<Slot> m_Slots;
+		std::size_t m_Next{};		// slot used by the next Begin()
+		bool m_Running{};
+	};
+}
@@ -0,0 +1,173 @@
+#include "HeadlessContext.hpp"
+#include "Renderer.hpp"
+
+#include <glad/glad.h>
+#include <stdexcept>
+
+#ifdef GAMEENGINE_HAS_EGL
+	#include <EGL/egl.h>
+	#include <EGL/eglext.h>
+	#include <cstring>
+#endif
+
+using namespace GameEngine;
+
+#ifdef GAMEENGINE_HAS_EGL
+
+// True when the space separated extension list contains the name
+static bool HasExtension(const char* extensions, const char* name)
+{
+	if (extensions == nullptr)
+		return false;
+
+	const std::size_t length{ std::strlen(name) };
+	for (const char* found = std::strstr(extensions, name); found != nullptr; found = std::strstr(found + length, name))
+	{
+		const bool starts{ found == extensions || found[-1] == ' ' };
+		const bool ends{ found[length] == ' ' || found[length] == '\0' };
+		if (starts && ends)
+			return true;
+	}
+
+	return false;
+}
+
+// Surfaceless Mesa display when possible, it needs neither X11 nor a GPU
+static EGLDisplay OpenDisplay()
+{
+	const char* clientExtensions{ eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS) };
+	if (HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+	{
+		auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		if (getPlatformDisplay != nullptr)
+		{
+			EGLDisplay display{ getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr) };
+			if (display != EGL_NO_DISPLAY)
+				return display;
+		}
+	}
+
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+// Picks a config for the surface type, returns false when there is none
+static bool ChooseConfig(EGLDisplay display, EGLint surfaceType, EGLConfig& config)
+{
+	const EGLint attributes[]{
+		EGL_SURFACE_TYPE, surfaceType,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_NONE };
+
+	EGLint count{};
+	return eglChooseConfig(display, attributes, &config, 1, &count) == EGL_TRUE && count > 0;
+}
+
+
+//						[CONSTRUCTORS]
+
+HeadlessContext::HeadlessContext(int width, int height)
+{
+	EGLDisplay display{ OpenDisplay() };
+	if (display == EGL_NO_DISPLAY || eglInitialize(display, nullptr, nullptr) != EGL_TRUE)
+		throw std::runtime_error("HeadlessContext.HeadlessContext error: no EGL display");
+	m_Display = display;
+
+	if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+	{
+		eglTerminate(display);
+		throw std::runtime_error("HeadlessContext.HeadlessContext error: EGL has no desktop OpenGL");
+	}
+
+	// A pbuffer when the display has one, otherwise no surface at all
+	EGLConfig config{};
+	const bool surfaceless{ HasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context") };
+	const bool pbuffer{ ChooseConfig(display, EGL_PBUFFER_BIT, config) };
+	if (!pbuffer && !(surfaceless && ChooseConfig(display, 0, config)))
+	{
+		eglTerminate(display);
+		throw std::runtime_error("HeadlessContext.HeadlessContext error: no suitable EGL config");
+	}
+
+	const EGLint contextAttributes[]{
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE };
+
+	EGLContext context{ eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes) };
+	if (context == EGL_NO_CONTEXT)
+	{
+		eglTerminate(display);
+		throw std::runtime_error("HeadlessContext.HeadlessContext error: failed to create an OpenGL 3.3 core context");
+	}
+	m_Context = context;
+
+	EGLSurface surface{ EGL_NO_SURFACE };
+	if (pbuffer)
+	{
+		const EGLint surfaceAttributes[]{ EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+		surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+	}
+	m_Surface = surface;
+
+	if (eglMakeCurrent(display, surface, surface, context) != EGL_TRUE
+		|| !gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+	{
+		if (surface != EGL_NO_SURFACE)
+			eglDestroySurface(display, surface);
+		eglDestroyContext(display, context);
+		eglTerminate(display);
+		throw std::runtime_error("HeadlessContext.HeadlessContext error: failed to make the context current");
+	}
+
+	m_Output = std::make_unique<RenderTarget>(width, height, GL_NEAREST);
+	Renderer::SetOutputFramebuffer(m_Output->Framebuffer());
+	Renderer::BindOutputFramebuffer();
+	glViewport(0, 0, width, height);
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	// GL objects go before the context
+	Renderer::SetOutputFramebuffer(0);
+	m_Output.reset();
+
+	eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (m_Surface != EGL_NO_SURFACE)
+		eglDestroySurface(m_Display, m_Surface);
+	eglDestroyContext(m_Display, m_Context);
+	eglTerminate(m_Display);
+}
+
+
+//						[GETTERS]
+
+bool HeadlessContext::Available() noexcept
+{
+	return true;
+}
+
+#else
+
+//						[CONSTRUCTORS]
+
+HeadlessContext::HeadlessContext(int, int)
+{
+	throw std::runtime_error("HeadlessContext.HeadlessContext error: built without EGL (define GAMEENGINE_HAS_EGL and link libEGL)");
+}
+
+HeadlessContext::~HeadlessContext() = default;
+
+
+//						[GETTERS]
+
+bool HeadlessContext::Available() noexcept
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include "RenderTarget.hpp"
+#include <memory>
+
+namespace GameEngine
+{
+	// OpenGL 3.3 core context without a window or a display, for benchmarks and CI.
+	// Uses EGL, surfaceless through EGL_MESA_platform_surfaceless when the driver has it
+	// (llvmpipe included), a pbuffer on the default display otherwise. Since there may be
+	// no default framebuffer, the frames go to an offscreen target that becomes the
+	// renderer's output framebuffer.
+	// Needs GAMEENGINE_HAS_EGL and libEGL, without them the constructor throws
+	class HeadlessContext
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Makes the context current and loads GLAD
+		// Exceptions: [runtime_error]
+		HeadlessContext(int width, int height);
+		~HeadlessContext();
+
+		HeadlessContext(const HeadlessContext&) = delete;
+		HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+
+		//				[GETTERS]
+
+		int Width() const noexcept { return m_Output->Width(); }
+		int Height() const noexcept { return m_Output->Height(); }
+		const RenderTarget& Output() const noexcept { return *m_Output; }
+
+		static bool Available() noexcept;
+
+	private:
+		void* m_Display{};
+		void* m_Context{};
+		void* m_Surface{};
+		std::unique_ptr<RenderTarget> m_Output;
+	};
+}
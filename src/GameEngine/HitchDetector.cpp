@@ -0,0 +1,149 @@
+#include "HitchDetector.hpp"
+#include "CpuProfiler.hpp"
+#include "GpuProfiler.hpp"
+#include "TraceWriter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+// Local date and time as YYYYMMDD_HHMMSS
+static std::string FileTimestamp()
+{
+	const std::time_t now{ std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) };
+	std::tm local{};
+#ifdef _WIN32
+	localtime_s(&local, &now);
+#else
+	localtime_r(&now, &local);
+#endif
+
+	char buffer[32]{};
+	std::strftime(buffer, sizeof(buffer), "%Y%m%d_%H%M%S", &local);
+	return buffer;
+}
+
+
+//						[CONSTRUCTORS]
+
+HitchDetector::HitchDetector(const HitchSettings& settings)
+	: m_Settings{ settings }
+{
+	m_Frames.reserve(m_Settings.framesBefore + m_Settings.framesAfter + 1);
+	m_RecentMs.reserve(medianWindow);
+	m_MedianScratch.reserve(medianWindow);
+	m_LastAllocations = CurrentAllocations();
+}
+
+
+//						[UTILITY]
+
+void HitchDetector::EndFrame(double frameMs, const GpuProfiler* gpuProfiler)
+{
+	const AllocationTotals allocations{ CurrentAllocations() };
+	const FrameRecord frame{ m_FrameIndex++, CpuProfiler::Now(), frameMs,
+		{ allocations.count - m_LastAllocations.count, allocations.bytes - m_LastAllocations.bytes } };
+	m_LastAllocations = allocations;
+
+	if (m_Frames.size() < m_Frames.capacity())
+		m_Frames.push_back(frame);
+	else
+		m_Frames[frame.index % m_Frames.size()] = frame;
+
+	// The median is taken before the frame joins the window, so the hitch does not hide itself
+	const double median{ Median() };
+	if (m_RecentMs.size() < medianWindow)
+		m_RecentMs.push_back(frameMs);
+	else
+		m_RecentMs[frame.index % medianWindow] = frameMs;
+
+	// The dump made the frame after it long, that is not a hitch of the game
+	const bool afterDump{ m_SkipNext };
+	m_SkipNext = false;
+
+	if (!m_Pending && !afterDump && m_RecentMs.size() >= medianWindow / 4
+		&& frameMs >= m_Settings.minimumMs && frameMs > median * m_Settings.medianMultiple)
+	{
+		++m_Hitches;
+		if (m_Dumps < m_Settings.maxDumps)
+		{
+			m_Pending = true;
+			m_PendingHitch = frame;
+			m_PendingMedian = median;
+		}
+	}
+
+	if (m_Pending && frame.index >= m_PendingHitch.index + m_Settings.framesAfter)
+	{
+		m_Pending = false;
+		m_SkipNext = true;
+		++m_Dumps;
+
+		// A read-only or full disk must not stop the game
+		try
+		{
+			Dump(gpuProfiler);
+		}
+		catch (const std::runtime_error& except)
+		{
+			std::cout << except.what() << '\n';
+		}
+	}
+}
+
+double HitchDetector::Median()
+{
+	if (m_RecentMs.empty())
+		return 0.0;
+
+	m_MedianScratch.assign(m_RecentMs.begin(), m_RecentMs.end());
+	auto middle = m_MedianScratch.begin() + static_cast<std::ptrdiff_t>(m_MedianScratch.size() / 2);
+	std::nth_element(m_MedianScratch.begin(), middle, m_MedianScratch.end());
+	return *middle;
+}
+
+void HitchDetector::Dump(const GpuProfiler* gpuProfiler)
+{
+	std::vector<FrameRecord> frames{ m_Frames };
+	std::sort(frames.begin(), frames.end(), [](const FrameRecord& a, const FrameRecord& b) { return a.index < b.index; });
+
+	// The oldest saved frame started its own duration before it ended
+	const FrameRecord& oldest = frames.front();
+	const std::uint64_t since{ oldest.end - static_cast<std::uint64_t>(oldest.ms * 1.0e6) };
+
+	std::filesystem::create_directories(m_Settings.directory);
+	const std::string path{ (std::filesystem::path{ m_Settings.directory }
+		/ std::format("hitch_{}_{}.json", FileTimestamp(), m_PendingHitch.index)).string() };
+
+	TraceWriter writer{ path, since };
+	CpuProfiler::Instance().WriteTrace(writer, since);
+
+	for (const FrameRecord& frame : frames)
+	{
+		writer.Counter("Frame ms", frame.end, frame.ms);
+		writer.Counter("Allocations", frame.end, static_cast<double>(frame.allocations.count));
+		writer.Counter("Allocated KiB", frame.end, static_cast<double>(frame.allocations.bytes) / 1024.0);
+	}
+
+	if (gpuProfiler != nullptr)
+	{
+		for (const GpuFrameRecord& record : gpuProfiler->History(since))
+		{
+			writer.Counter("GPU frame ms", record.cpuTime, record.frameMs);
+			for (const GpuFrameRecord::ScopeTime& scope : record.scopes)
+				writer.Counter(std::format("GPU {} ms", scope.name), record.cpuTime, scope.ms);
+		}
+	}
+
+	writer.Finish(std::format(R"("hitch":{{"frame":{},"ms":{:.3f},"medianMs":{:.3f},"allocations":{},"allocatedBytes":{}}})",
+		m_PendingHitch.index, m_PendingHitch.ms, m_PendingMedian, m_PendingHitch.allocations.count, m_PendingHitch.allocations.bytes));
+
+	m_LastDump = path;
+	std::cout << std::format("Hitch of {:.2f} ms (median {:.2f} ms) saved to {}\n", m_PendingHitch.ms, m_PendingMedian, path);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "AllocationCounter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	class GpuProfiler;
+
+	struct HitchSettings
+	{
+		double		medianMultiple{ 2.5 };		// a frame this many times longer than the median is a hitch
+		double		minimumMs{ 8.0 };			// shorter frames never count, fast frames are noisy
+		std::size_t	framesBefore{ 60 };			// frames saved before the hitch
+		std::size_t	framesAfter{ 10 };			// frames waited for and saved after it
+		std::size_t	maxDumps{ 20 };				// per session
+		std::string	directory{ "hitches" };
+	};
+
+	// Watches the frame times and, a few frames after a hitch, saves the CPU zones,
+	// markers (asset loads, shader compiles), GPU pass times and per-frame allocations
+	// of the surrounding frames to <directory>/hitch_<date>_<time>_<frame>.json.
+	// The file is a Chrome trace with an extra "hitch" object
+	class HitchDetector
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		explicit HitchDetector(const HitchSettings& settings = {});
+
+
+		//				[GETTERS]
+
+		std::size_t Hitches() const noexcept { return m_Hitches; }
+		const std::string& LastDump() const noexcept { return m_LastDump; }
+
+
+		//				[UTILITY]
+
+		// Call once per frame after PROFILE_FRAME(), frameMs is the duration of the previous frame.
+		// A dump that fails to write is logged and counts against maxDumps
+		void EndFrame(double frameMs, const GpuProfiler* gpuProfiler = nullptr);
+
+	private:
+		struct FrameRecord
+		{
+			std::uint64_t	index{};
+			std::uint64_t	end{};			// CpuProfiler::Now()
+			double			ms{};
+			AllocationTotals allocations{};	// during the frame
+		};
+
+		static constexpr std::size_t medianWindow{ 120 };
+
+		HitchSettings m_Settings;
+		std::vector<FrameRecord> m_Frames;		// ring of framesBefore + framesAfter + 1
+		std::vector<double> m_RecentMs;			// ring of medianWindow for the median
+		std::uint64_t m_FrameIndex{};
+		AllocationTotals m_LastAllocations{};
+
+		bool m_Pending{};
+		bool m_SkipNext{};						// the frame after a dump
+		FrameRecord m_PendingHitch{};
+		double m_PendingMedian{};
+		std::size_t m_Hitches{};
+		std::size_t m_Dumps{};
+		std::string m_LastDump;
+
+		std::vector<double> m_MedianScratch;		// reused, the detector must not show up in the allocation counts
+
+		double Median();
+
+		// Exceptions: [runtime_error]
+		void Dump(const GpuProfiler* gpuProfiler);
+	};
+}
@@ -0,0 +1,55 @@
+#include "Image.hpp"
+#include "CpuProfiler.hpp"
+
+#include <format>
+#include <stdexcept>
+
+#include "stb_image.h"
+
+using namespace GameEngine;
+
+// Takes over the stb_image buffer, freeing it
+static Image TakeDecoded(unsigned char* data, int width, int height, int fileChannels, int desiredChannels)
+{
+	Image image{ width, height, desiredChannels != 0 ? desiredChannels : fileChannels, {} };
+	image.pixels.assign(data, data + static_cast<std::size_t>(image.width) * image.height * image.channels);
+	stbi_image_free(data);
+
+	return image;
+}
+
+Image GameEngine::LoadImage(const std::string& imagePath, int desiredChannels)
+{
+	PROFILE_ZONE("Image decode");
+	PROFILE_MARKER("Asset load", imagePath);
+
+	int width{}, height{}, fileChannels{};
+
+	stbi_set_flip_vertically_on_load_thread(true);
+	unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &fileChannels, desiredChannels);
+	if (!data)
+	{
+		std::string error = std::format("Image.LoadImage error: cannot load image file:\n{}", imagePath);
+		throw std::runtime_error(error);
+	}
+
+	return TakeDecoded(data, width, height, fileChannels, desiredChannels);
+}
+
+Image GameEngine::DecodeImage(std::span<const unsigned char> bytes, int desiredChannels, const std::string& name)
+{
+	PROFILE_ZONE("Image decode");
+	PROFILE_MARKER("Asset load", name);
+
+	int width{}, height{}, fileChannels{};
+
+	stbi_set_flip_vertically_on_load_thread(true);
+	unsigned char* data = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &fileChannels, desiredChannels);
+	if (!data)
+	{
+		std::string error = std::format("Image.DecodeImage error: cannot decode image:\n{}", name);
+		throw std::runtime_error(error);
+	}
+
+	return TakeDecoded(data, width, height, fileChannels, desiredChannels);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// Decoded image in CPU memory, rows go bottom to top as OpenGL expects them
+	struct Image
+	{
+		int width{};
+		int height{};
+		int channels{};
+		std::vector<unsigned char> pixels;
+	};
+
+	// Decodes an image file, desiredChannels = 0 keeps the channels of the file
+	// Exceptions: [runtime_error]
+	Image LoadImage(const std::string& imagePath, int desiredChannels = 0);
+
+	// Decodes an image file already in memory (e.g. from an AssetPack), name is for the error message
+	// Exceptions: [runtime_error]
+	Image DecodeImage(std::span<const unsigned char> bytes, int desiredChannels = 0, const std::string& name = {});
+}
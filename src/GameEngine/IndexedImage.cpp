@@ -0,0 +1,125 @@
+#include "IndexedImage.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace GameEngine;
+
+static constexpr unsigned char pngSignature[]{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+static constexpr unsigned char indexedColorType{ 3 };
+
+static std::uint32_t ReadBigEndian32(const unsigned char* bytes) noexcept
+{
+	return std::uint32_t{ bytes[0] } << 24 | std::uint32_t{ bytes[1] } << 16 | std::uint32_t{ bytes[2] } << 8 | bytes[3];
+}
+
+std::vector<unsigned char> GameEngine::ReadPngPalette(std::span<const unsigned char> png)
+{
+	if (png.size() < sizeof(pngSignature) || std::memcmp(png.data(), pngSignature, sizeof(pngSignature)) != 0)
+		return {};
+
+	std::vector<unsigned char> palette;
+	std::size_t position{ sizeof(pngSignature) };
+
+	// Chunks: length, type, data, CRC. PLTE and tRNS come before the image data
+	while (png.size() - position >= 12)
+	{
+		const std::size_t length{ ReadBigEndian32(png.data() + position) };
+		const unsigned char* type = png.data() + position + 4;
+		const unsigned char* data = type + 4;
+		if (length > png.size() - position - 12)
+			return {};
+
+		if (std::memcmp(type, "IHDR", 4) == 0 && (length < 13 || data[9] != indexedColorType))
+			return {};
+		if (std::memcmp(type, "PLTE", 4) == 0 && length % 3 == 0 && length / 3 <= 256)
+		{
+			for (std::size_t i = 0; i < length; i += 3)
+				palette.insert(palette.end(), { data[i], data[i + 1], data[i + 2], 255 });
+		}
+		if (std::memcmp(type, "tRNS", 4) == 0)
+		{
+			for (std::size_t i = 0; i < length && i * 4 + 3 < palette.size(); ++i)
+				palette[i * 4 + 3] = data[i];
+		}
+		if (std::memcmp(type, "IDAT", 4) == 0)
+			break;
+
+		position += length + 12;
+	}
+
+	return palette;
+}
+
+std::optional<IndexedImage> GameEngine::IndexImage(const Image& image, std::span<const unsigned char> palette)
+{
+	if (image.channels != 4 || palette.empty() || palette.size() % 4 != 0 || palette.size() > 256 * 4)
+		return std::nullopt;
+
+	std::unordered_map<std::uint32_t, unsigned char> lookup;
+	for (std::size_t i = palette.size() / 4; i-- > 0;)
+	{
+		std::uint32_t color;
+		std::memcpy(&color, palette.data() + i * 4, sizeof(color));
+		lookup[color] = static_cast<unsigned char>(i);
+	}
+
+	IndexedImage indexed{ image.width, image.height, {}, {} };
+	indexed.indices.resize(static_cast<std::size_t>(image.width) * image.height);
+	indexed.palette.assign(palette.begin(), palette.end());
+
+	// Neighbouring pixels mostly repeat, the last match saves most of the lookups
+	std::uint32_t lastColor{};
+	unsigned char lastIndex{};
+	bool hasLast{};
+	for (std::size_t i = 0; i < indexed.indices.size(); ++i)
+	{
+		std::uint32_t color;
+		std::memcpy(&color, image.pixels.data() + i * 4, sizeof(color));
+		if (!hasLast || color != lastColor)
+		{
+			const auto found = lookup.find(color);
+			if (found == lookup.end())
+				return std::nullopt;
+
+			lastColor = color;
+			lastIndex = found->second;
+			hasLast = true;
+		}
+		indexed.indices[i] = lastIndex;
+	}
+
+	return indexed;
+}
+
+Image GameEngine::ExpandIndexedImage(const IndexedImage& image)
+{
+	Image expanded{ image.width, image.height, 4, {} };
+	expanded.pixels.resize(image.indices.size() * 4);
+	for (std::size_t i = 0; i < image.indices.size(); ++i)
+	{
+		const std::size_t entry{ static_cast<std::size_t>(image.indices[i]) * 4 };
+		if (entry + 4 <= image.palette.size())
+			std::memcpy(expanded.pixels.data() + i * 4, image.palette.data() + entry, 4);
+	}
+
+	return expanded;
+}
+
+std::optional<IndexedImage> GameEngine::LoadIndexedImage(const std::string& imagePath)
+{
+	std::ifstream file{ imagePath, std::ios::binary };
+	if (!file)
+		throw std::runtime_error("IndexedImage.LoadIndexedImage error: can't open " + imagePath);
+
+	const std::vector<unsigned char> bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	const std::vector<unsigned char> palette{ ReadPngPalette(bytes) };
+	if (palette.empty())
+		return std::nullopt;
+
+	return IndexImage(DecodeImage(bytes, 4, imagePath), palette);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "Image.hpp"
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// 8-bit color map image: one palette index per pixel, rows bottom to top like Image
+	struct IndexedImage
+	{
+		int width{};
+		int height{};
+		std::vector<unsigned char> indices;
+		std::vector<unsigned char> palette;		// RGBA, at most 256 colors in the file order
+	};
+
+	// PLTE colors with the tRNS alpha of a PNG with a color map, empty for any other image
+	std::vector<unsigned char> ReadPngPalette(std::span<const unsigned char> png);
+
+	// Finds the palette index of every pixel of an RGBA image, the first entry wins for repeated colors:
+	// the decoded pixels no longer tell which of them the file used, so the indices may differ from the file ones.
+	// Empty when a pixel has a color that is not in the palette
+	std::optional<IndexedImage> IndexImage(const Image& image, std::span<const unsigned char> palette);
+
+	// RGBA pixels of the indexed image
+	Image ExpandIndexedImage(const IndexedImage& image);
+
+	// Loads a PNG with a color map keeping its palette, empty for any other image
+	// Exceptions: [runtime_error]
+	std::optional<IndexedImage> LoadIndexedImage(const std::string& imagePath);
+}
@@ -0,0 +1,122 @@
+#include "JobSystem.hpp"
+#include "CpuProfiler.hpp"
+
+#include <algorithm>
+#include <exception>
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+	m_Workers.reserve(workerCount);
+	for (unsigned int i = 0; i < workerCount; ++i)
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock{ m_Mutex };
+		m_Stopping = true;
+	}
+
+	m_Condition.notify_all();
+	for (std::thread& worker : m_Workers)
+		worker.join();
+}
+
+
+//						[UTILITY]
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t chunkCount, const std::function<void(std::size_t, std::size_t, std::size_t)>& job)
+{
+	if (count == 0)
+		return;
+
+	chunkCount = std::clamp<std::size_t>(chunkCount, 1, count);
+	const std::size_t chunkSize{ (count + chunkCount - 1) / chunkCount };
+	chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	// The first range is done by the calling thread, the rest goes to the workers
+	std::vector<std::future<void>> pending;
+	pending.reserve(chunkCount - 1);
+	for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+	{
+		const std::size_t begin{ chunk * chunkSize };
+		const std::size_t end{ std::min(count, begin + chunkSize) };
+
+		pending.push_back(Submit([&job, begin, end, chunk]() { job(begin, end, chunk); }));
+	}
+
+	// Every range has to finish before leaving, the workers hold a reference to job
+	std::exception_ptr error;
+	try
+	{
+		job(0, std::min(count, chunkSize), 0);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	for (std::future<void>& result : pending)
+	{
+		try
+		{
+			result.get();
+		}
+		catch (...)
+		{
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+unsigned int JobSystem::DefaultWorkerCount() noexcept
+{
+	const unsigned int hardwareThreads{ std::thread::hardware_concurrency() };
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+
+//						[PRIVATE]
+
+void JobSystem::Enqueue(std::function<void()> job)
+{
+	{
+		std::lock_guard lock{ m_Mutex };
+		m_Jobs.push(std::move(job));
+	}
+
+	m_Condition.notify_one();
+}
+
+void JobSystem::WorkerLoop()
+{
+	PROFILE_THREAD("Job worker");
+
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock lock{ m_Mutex };
+			m_Condition.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+
+			if (m_Stopping && m_Jobs.empty())
+				return;
+
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop();
+		}
+
+		PROFILE_ZONE("Job");
+		job();
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GameEngine
+{
+	// Fixed pool of worker threads fed from a single FIFO queue
+	class JobSystem
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// By default leaves one hardware thread for the main loop
+		explicit JobSystem(unsigned int workerCount = DefaultWorkerCount());
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		~JobSystem();
+
+
+		//				[GETTERS]
+
+		unsigned int WorkerCount() const noexcept { return static_cast<unsigned int>(m_Workers.size()); }
+
+
+		//				[UTILITY]
+
+		// Queues the job, the future receives its result or exception
+		template <typename Function>
+		auto Submit(Function&& job) -> std::future<std::invoke_result_t<std::decay_t<Function>>>;
+
+		// Splits [0; count) into at most chunkCount contiguous ranges and runs
+		// job(begin, end, chunkIndex) for each of them. The calling thread takes part
+		// in the work and the function returns when every range is done.
+		// Must not be called from inside a job, the pool could run out of free workers.
+		// Exceptions: the first one thrown by a job
+		void ParallelFor(std::size_t count, std::size_t chunkCount, const std::function<void(std::size_t, std::size_t, std::size_t)>& job);
+
+		static unsigned int DefaultWorkerCount() noexcept;
+
+	private:
+		std::vector<std::thread> m_Workers;
+		std::queue<std::function<void()>> m_Jobs;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_Stopping{};
+
+		void Enqueue(std::function<void()> job);
+		void WorkerLoop();
+	};
+
+
+	template <typename Function>
+	auto JobSystem::Submit(Function&& job) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+	{
+		using result_type = std::invoke_result_t<std::decay_t<Function>>;
+
+		// packaged_task is move-only while std::function needs a copyable target
+		auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Function>(job));
+		std::future<result_type> result = task->get_future();
+
+		Enqueue([task]() { (*task)(); });
+		return result;
+	}
+}
@@ -0,0 +1,187 @@
+#include "Lz4.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace GameEngine;
+
+static constexpr std::size_t minMatch{ 4 };
+static constexpr std::size_t lastLiterals{ 5 };		// the block always ends with that many literals
+static constexpr std::size_t matchFindLimit{ 12 };	// and its last match starts that far from the end
+static constexpr std::size_t maxOffset{ 65535 };
+static constexpr int hashBits{ 14 };
+
+static std::uint32_t Read32(const unsigned char* bytes) noexcept
+{
+	std::uint32_t value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+static std::uint32_t HashOf(std::uint32_t sequence) noexcept
+{
+	return (sequence * 2654435761u) >> (32 - hashBits);
+}
+
+// 15 in the token nibble, then 255s and the remainder
+static unsigned char* WriteLength(unsigned char* out, std::size_t length) noexcept
+{
+	for (; length >= 255; length -= 255)
+		*out++ = 255;
+	*out++ = static_cast<unsigned char>(length);
+	return out;
+}
+
+// Token, literals and the match, matchLength 0 writes the last literals only
+static unsigned char* WriteSequence(unsigned char* out, const unsigned char* outEnd,
+	const unsigned char* literals, std::size_t literalCount, std::size_t matchLength, std::size_t offset) noexcept
+{
+	const std::size_t worstCase{ 1 + literalCount / 255 + 1 + literalCount + 2 + matchLength / 255 + 1 };
+	if (worstCase > static_cast<std::size_t>(outEnd - out))
+		return nullptr;
+
+	unsigned char* token = out++;
+	*token = static_cast<unsigned char>((literalCount >= 15 ? 15 : literalCount) << 4);
+	if (literalCount >= 15)
+		out = WriteLength(out, literalCount - 15);
+
+	std::memcpy(out, literals, literalCount);
+	out += literalCount;
+	if (matchLength == 0)
+		return out;
+
+	*out++ = static_cast<unsigned char>(offset & 0xFF);
+	*out++ = static_cast<unsigned char>(offset >> 8);
+
+	const std::size_t storedLength{ matchLength - minMatch };
+	*token |= static_cast<unsigned char>(storedLength >= 15 ? 15 : storedLength);
+	if (storedLength >= 15)
+		out = WriteLength(out, storedLength - 15);
+
+	return out;
+}
+
+std::size_t GameEngine::Lz4Compress(std::span<const unsigned char> source, std::span<unsigned char> destination)
+{
+	const unsigned char* in = source.data();
+	const std::size_t size{ source.size() };
+	unsigned char* out = destination.data();
+	const unsigned char* outEnd = destination.data() + destination.size();
+
+	std::size_t anchor{};
+	if (size > matchFindLimit)
+	{
+		// Last position seen for each hash of 4 bytes, a stale or colliding one fails the compare
+		std::vector<std::uint32_t> table(std::size_t{ 1 } << hashBits);
+		const std::size_t searchEnd{ size - matchFindLimit };
+		const std::size_t matchEnd{ size - lastLiterals };
+
+		std::size_t position{ 1 };
+		while (position <= searchEnd)
+		{
+			const std::uint32_t sequence{ Read32(in + position) };
+			std::uint32_t& slot = table[HashOf(sequence)];
+			std::size_t candidate{ slot };
+			slot = static_cast<std::uint32_t>(position);
+
+			if (candidate >= position || position - candidate > maxOffset || Read32(in + candidate) != sequence)
+			{
+				// Incompressible stretches are skipped faster and faster
+				position += 1 + ((position - anchor) >> 6);
+				continue;
+			}
+
+			while (position > anchor && candidate > 0 && in[position - 1] == in[candidate - 1])
+			{
+				--position;
+				--candidate;
+			}
+
+			std::size_t length{ minMatch };
+			while (position + length < matchEnd && in[position + length] == in[candidate + length])
+				++length;
+
+			out = WriteSequence(out, outEnd, in + anchor, position - anchor, length, position - candidate);
+			if (out == nullptr)
+				return 0;
+
+			position += length;
+			anchor = position;
+		}
+	}
+
+	out = WriteSequence(out, outEnd, in + anchor, size - anchor, 0, 0);
+	return out == nullptr ? 0 : static_cast<std::size_t>(out - destination.data());
+}
+
+std::size_t GameEngine::Lz4Decompress(std::span<const unsigned char> source, std::span<unsigned char> destination)
+{
+	const unsigned char* in = source.data();
+	const unsigned char* inEnd = source.data() + source.size();
+	unsigned char* out = destination.data();
+	unsigned char* const outEnd = destination.data() + destination.size();
+
+	auto readLength = [&in, inEnd](std::size_t length)
+	{
+		unsigned char byte;
+		do
+		{
+			if (in == inEnd)
+				throw std::runtime_error("Lz4Decompress error: corrupted block");
+			byte = *in++;
+			length += byte;
+		} while (byte == 255);
+
+		return length;
+	};
+
+	for (;;)
+	{
+		if (in == inEnd)
+			throw std::runtime_error("Lz4Decompress error: corrupted block");
+
+		const unsigned char token{ *in++ };
+		std::size_t literalCount{ static_cast<std::size_t>(token >> 4) };
+		if (literalCount == 15)
+			literalCount = readLength(literalCount);
+
+		if (literalCount > static_cast<std::size_t>(inEnd - in) || literalCount > static_cast<std::size_t>(outEnd - out))
+			throw std::runtime_error("Lz4Decompress error: corrupted block or too small destination");
+		std::memcpy(out, in, literalCount);
+		in += literalCount;
+		out += literalCount;
+
+		// The last sequence has no match
+		if (in == inEnd)
+			break;
+
+		if (inEnd - in < 2)
+			throw std::runtime_error("Lz4Decompress error: corrupted block");
+		const std::size_t offset{ static_cast<std::size_t>(in[0]) | static_cast<std::size_t>(in[1]) << 8 };
+		in += 2;
+		if (offset == 0 || offset > static_cast<std::size_t>(out - destination.data()))
+			throw std::runtime_error("Lz4Decompress error: corrupted block");
+
+		std::size_t length{ static_cast<std::size_t>(token & 15) };
+		if (length == 15)
+			length = readLength(length);
+		length += minMatch;
+		if (length > static_cast<std::size_t>(outEnd - out))
+			throw std::runtime_error("Lz4Decompress error: corrupted block or too small destination");
+
+		// Overlapping matches repeat the last offset bytes, they have to go one byte at a time
+		const unsigned char* match = out - offset;
+		if (offset >= length)
+			std::memcpy(out, match, length);
+		else
+		{
+			for (std::size_t i = 0; i < length; ++i)
+				out[i] = match[i];
+		}
+		out += length;
+	}
+
+	return static_cast<std::size_t>(out - destination.data());
+}
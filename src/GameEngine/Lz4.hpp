@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+namespace GameEngine
+{
+	// LZ4 block format (no frame), readable by the reference lz4 library and the other way round.
+	// Fast enough to decompress at several GB/s per core, the ratio is lower than deflate
+
+	// Largest compressed size of a source of that size (incompressible data grows a little)
+	constexpr std::size_t Lz4CompressBound(std::size_t size) noexcept { return size + size / 255 + 16; }
+
+	// Compressed size, 0 when the destination is too small
+	std::size_t Lz4Compress(std::span<const unsigned char> source, std::span<unsigned char> destination);
+
+	// Decompressed size. Never writes outside the destination
+	// Exceptions: [runtime_error] on corrupted data or a too small destination
+	std::size_t Lz4Decompress(std::span<const unsigned char> source, std::span<unsigned char> destination);
+}
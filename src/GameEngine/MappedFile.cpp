@@ -0,0 +1,89 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+{
+	HANDLE file{ CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("MappedFile.MappedFile error: can't open " + path);
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		throw std::runtime_error("MappedFile.MappedFile error: empty or unreadable file " + path);
+	}
+
+	HANDLE mapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+	const void* view{ mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr };
+	if (view == nullptr)
+	{
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::runtime_error("MappedFile.MappedFile error: can't map " + path);
+	}
+
+	m_File = file;
+	m_Mapping = mapping;
+	m_Data = static_cast<const unsigned char*>(view);
+	m_Size = static_cast<std::size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+	UnmapViewOfFile(m_Data);
+	CloseHandle(static_cast<HANDLE>(m_Mapping));
+	CloseHandle(static_cast<HANDLE>(m_File));
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+	const int file{ open(path.c_str(), O_RDONLY) };
+	if (file < 0)
+		throw std::runtime_error("MappedFile.MappedFile error: can't open " + path);
+
+	struct stat status{};
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		close(file);
+		throw std::runtime_error("MappedFile.MappedFile error: empty or unreadable file " + path);
+	}
+
+	// The mapping keeps the file referenced, the descriptor is not needed any more
+	void* view{ mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0) };
+	close(file);
+	if (view == MAP_FAILED)
+		throw std::runtime_error("MappedFile.MappedFile error: can't map " + path);
+
+	m_Data = static_cast<const unsigned char*>(view);
+	m_Size = static_cast<std::size_t>(status.st_size);
+}
+
+MappedFile::~MappedFile()
+{
+	munmap(const_cast<unsigned char*>(m_Data), m_Size);
+}
+
+#endif
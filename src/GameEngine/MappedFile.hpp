@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace GameEngine
+{
+	// Read-only view of a whole file through the virtual memory system
+	// (mmap, CreateFileMapping on Windows). Pages are read from disk on first touch
+	// and shared with the OS file cache, nothing is copied into the process
+	class MappedFile
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		explicit MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+
+		//				[GETTERS]
+
+		std::span<const unsigned char> Bytes() const noexcept { return { m_Data, m_Size }; }
+		std::size_t Size() const noexcept { return m_Size; }
+
+	private:
+		const unsigned char* m_Data{};
+		std::size_t m_Size{};
+		void* m_File{};			// Windows file and mapping handles
+		void* m_Mapping{};
+	};
+}
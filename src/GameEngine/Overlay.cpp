@@ -0,0 +1,88 @@
+#include "Overlay.hpp"
+#include "VertexLayout.hpp"
+#include "Renderer.hpp"
+
+#include <glad/glad.h>
+
+using namespace GameEngine;
+
+struct Overlay::Vertex
+{
+	float			x;
+	float			y;
+	std::uint32_t	color;
+
+	using Layout = VertexLayout<
+		VertexAttribute<float, 2>,
+		VertexAttribute<std::uint8_t, 4, AttributeMode::Normalized>>;
+};
+
+
+//						[CONSTRUCTORS]
+
+Overlay::Overlay(const std::string& shaderPath)
+	: m_Shader{ shaderPath + "overlay.vert", shaderPath + "overlay.frag" }
+{
+	static_assert(sizeof(Vertex) == Vertex::Layout::stride, "Overlay.Vertex does not match its layout");
+
+	glGenVertexArrays(1, &m_VAO);
+	glBindVertexArray(m_VAO);
+
+	glGenBuffers(1, &m_VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+	Vertex::Layout::Apply();
+	glBindVertexArray(0);
+}
+
+Overlay::~Overlay()
+{
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteProgram(m_Shader.GetID());
+}
+
+
+//						[UTILITY]
+
+void Overlay::Rect(float x, float y, float width, float height, std::uint32_t color)
+{
+	const Vertex topLeft{ x, y, color };
+	const Vertex topRight{ x + width, y, color };
+	const Vertex bottomRight{ x + width, y + height, color };
+	const Vertex bottomLeft{ x, y + height, color };
+
+	m_Vertices.insert(m_Vertices.end(), { topLeft, topRight, bottomRight, bottomRight, bottomLeft, topLeft });
+}
+
+void Overlay::Draw(int windowWidth, int windowHeight)
+{
+	if (m_Vertices.empty())
+		return;
+
+	const GLboolean depthTest{ glIsEnabled(GL_DEPTH_TEST) };
+	const GLboolean blend{ glIsEnabled(GL_BLEND) };
+
+	Renderer::BindOutputFramebuffer();
+	glViewport(0, 0, windowWidth, windowHeight);
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), m_Vertices.data(), GL_STREAM_DRAW);
+
+	m_Shader.Use();
+	m_Shader.SetFloat4("windowSize", static_cast<float>(windowWidth), static_cast<float>(windowHeight), 0.0f, 0.0f);
+
+	glBindVertexArray(m_VAO);
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_Vertices.size()));
+	glBindVertexArray(0);
+
+	if (depthTest)
+		glEnable(GL_DEPTH_TEST);
+	if (!blend)
+		glDisable(GL_BLEND);
+
+	m_Vertices.clear();
+}
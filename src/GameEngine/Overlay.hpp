@@ -0,0 +1,41 @@
+#pragma once
+#include "Shader.hpp"
+#include "Sprite.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// Immediate mode debug overlay made of flat colored rectangles in window pixels
+	// (top-left origin). Used for profiler bars and graphs, there is no text rendering
+	class Overlay
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		explicit Overlay(const std::string& shaderPath);
+		~Overlay();
+
+		Overlay(const Overlay&) = delete;
+		Overlay& operator=(const Overlay&) = delete;
+
+
+		//				[UTILITY]
+
+		// color is RGBA8, see PackColor()
+		void Rect(float x, float y, float width, float height, std::uint32_t color);
+
+		// Draws the queued rectangles over the default framebuffer and clears the queue
+		void Draw(int windowWidth, int windowHeight);
+
+	private:
+		struct Vertex;
+
+		Shader m_Shader;
+		unsigned int m_VAO{};
+		unsigned int m_VBO{};
+		std::vector<Vertex> m_Vertices;
+	};
+}
@@ -0,0 +1,54 @@
+#include "Palette.hpp"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+Palette::Palette(std::span<const unsigned char> colors)
+{
+	glGenTextures(1, &m_Texture);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+
+	// Indices are exact, the colors must not be blended with their neighbours
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, maxColors, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+	Update(colors);
+}
+
+Palette::~Palette()
+{
+	glDeleteTextures(1, &m_Texture);
+}
+
+
+//						[UTILITY]
+
+void Palette::Update(std::span<const unsigned char> colors)
+{
+	if (colors.size() % 4 != 0 || colors.size() > maxColors * 4)
+		throw std::runtime_error("Palette.Update error: expected at most 256 RGBA colors");
+
+	std::array<unsigned char, maxColors * 4> full{};
+	std::copy(colors.begin(), colors.end(), full.begin());
+
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, maxColors, 1, GL_RGBA, GL_UNSIGNED_BYTE, full.data());
+}
+
+void Palette::Bind(int unit) const
+{
+	glActiveTexture(GL_TEXTURE0 + unit);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+	glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <span>
+
+namespace GameEngine
+{
+	// Texture unit the sprite shaders read the palette from, the index texture stays on unit 0
+	inline constexpr int paletteTextureUnit{ 2 };
+
+	// Up to 256 RGBA colors in a 256x1 texture, looked up by the indices of a palettized Texture.
+	// Binding another palette over the texture's own one recolors it without a second copy of the pixels
+	class Palette
+	{
+	public:
+		static constexpr int maxColors{ 256 };
+
+		//				[CONSTRUCTORS]
+
+		// RGBA bytes of at most maxColors colors, the missing ones are transparent black
+		// Exceptions: [runtime_error]
+		explicit Palette(std::span<const unsigned char> colors);
+		~Palette();
+
+		Palette(const Palette&) = delete;
+		Palette& operator=(const Palette&) = delete;
+
+
+		//				[GETTERS]
+
+		unsigned int GetID() const noexcept { return m_Texture; }
+
+
+		//				[UTILITY]
+
+		// Replaces the colors in place (palette swaps, color cycling)
+		// Exceptions: [runtime_error]
+		void Update(std::span<const unsigned char> colors);
+
+		void Bind(int unit = paletteTextureUnit) const;
+
+	private:
+		unsigned int m_Texture{};
+	};
+}
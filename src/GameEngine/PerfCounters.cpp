@@ -0,0 +1,166 @@
+#include "PerfCounters.hpp"
+
+#include <atomic>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <array>
+	#include <cstring>
+#endif
+
+using namespace GameEngine;
+
+static std::atomic<bool> enabled{};
+
+//						[PerfCounts]
+
+PerfCounts& PerfCounts::operator+=(const PerfCounts& other) noexcept
+{
+	instructions += other.instructions;
+	cycles += other.cycles;
+	cacheMisses += other.cacheMisses;
+	branchMisses += other.branchMisses;
+	return *this;
+}
+
+PerfCounts PerfCounts::operator-(const PerfCounts& other) const noexcept
+{
+	return { instructions - other.instructions, cycles - other.cycles, cacheMisses - other.cacheMisses, branchMisses - other.branchMisses };
+}
+
+double PerfCounts::InstructionsPerCycle() const noexcept
+{
+	return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+}
+
+double PerfCounts::CacheMissesPerKiloInstruction() const noexcept
+{
+	return instructions > 0 ? static_cast<double>(cacheMisses) * 1000.0 / static_cast<double>(instructions) : 0.0;
+}
+
+double PerfCounts::BranchMissesPerKiloInstruction() const noexcept
+{
+	return instructions > 0 ? static_cast<double>(branchMisses) * 1000.0 / static_cast<double>(instructions) : 0.0;
+}
+
+
+#ifdef __linux__
+
+namespace
+{
+	constexpr std::array<std::uint64_t, 4> counterConfigs{
+		PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+	// Counter group of one thread, the first opened counter leads it
+	class ThreadCounters
+	{
+	public:
+		ThreadCounters()
+		{
+			for (std::size_t i = 0; i < counterConfigs.size(); ++i)
+			{
+				perf_event_attr attributes{};
+				attributes.size = sizeof(attributes);
+				attributes.type = PERF_TYPE_HARDWARE;
+				attributes.config = counterConfigs[i];
+				attributes.disabled = m_Leader < 0 ? 1 : 0;
+				attributes.exclude_kernel = 1;
+				attributes.exclude_hv = 1;
+				attributes.read_format = PERF_FORMAT_GROUP;
+
+				// Counters the CPU or the kernel does not allow are left out of the group
+				const int fd{ static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, m_Leader, 0)) };
+				if (fd < 0)
+					continue;
+
+				if (m_Leader < 0)
+					m_Leader = fd;
+				m_Fds[m_Count] = fd;
+				m_Slots[m_Count++] = i;
+			}
+
+			if (m_Leader >= 0)
+			{
+				ioctl(m_Leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(m_Leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			}
+		}
+
+		~ThreadCounters()
+		{
+			// The leader goes last
+			for (std::size_t i = m_Count; i > 0; --i)
+				close(m_Fds[i - 1]);
+		}
+
+		bool Valid() const noexcept { return m_Leader >= 0; }
+
+		PerfCounts Read() const noexcept
+		{
+			// PERF_FORMAT_GROUP layout: count, then the values in the order the counters were opened
+			std::array<std::uint64_t, 1 + counterConfigs.size()> buffer{};
+			if (m_Leader < 0 || read(m_Leader, buffer.data(), sizeof(buffer)) <= 0)
+				return {};
+
+			std::array<std::uint64_t, counterConfigs.size()> values{};
+			for (std::size_t i = 0; i < m_Count && i < buffer[0]; ++i)
+				values[m_Slots[i]] = buffer[1 + i];
+
+			return { values[0], values[1], values[2], values[3] };
+		}
+
+	private:
+		int m_Leader{ -1 };
+		std::array<int, counterConfigs.size()> m_Fds{};
+		std::array<std::size_t, counterConfigs.size()> m_Slots{};		// counter index of each group value
+		std::size_t m_Count{};
+	};
+
+	ThreadCounters& CurrentThreadCounters()
+	{
+		static thread_local ThreadCounters counters;
+		return counters;
+	}
+}
+
+bool PerfCounters::Enable()
+{
+	const bool valid{ CurrentThreadCounters().Valid() };
+	enabled.store(valid, std::memory_order_relaxed);
+	return valid;
+}
+
+PerfCounts PerfCounters::Read() noexcept
+{
+	if (!enabled.load(std::memory_order_relaxed))
+		return {};
+
+	return CurrentThreadCounters().Read();
+}
+
+#else
+
+bool PerfCounters::Enable()
+{
+	return false;
+}
+
+PerfCounts PerfCounters::Read() noexcept
+{
+	return {};
+}
+
+#endif
+
+void PerfCounters::Disable() noexcept
+{
+	enabled.store(false, std::memory_order_relaxed);
+}
+
+bool PerfCounters::Enabled() noexcept
+{
+	return enabled.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+namespace GameEngine
+{
+	// Hardware counter values of the calling thread (user space only)
+	struct PerfCounts
+	{
+		std::uint64_t instructions{};
+		std::uint64_t cycles{};
+		std::uint64_t cacheMisses{};
+		std::uint64_t branchMisses{};
+
+		PerfCounts& operator+=(const PerfCounts& other) noexcept;
+		PerfCounts operator-(const PerfCounts& other) const noexcept;
+
+		double InstructionsPerCycle() const noexcept;
+		double CacheMissesPerKiloInstruction() const noexcept;
+		double BranchMissesPerKiloInstruction() const noexcept;
+	};
+
+	// Optional hardware counters for the profiler zones, read with perf_event_open on Linux.
+	// Every thread opens its own counter group on its first read after Enable().
+	// Elsewhere, or when the kernel refuses (perf_event_paranoid, VMs), the counts stay zero
+	namespace PerfCounters
+	{
+		// Returns false when the counters are not available on this machine
+		bool Enable();
+		void Disable() noexcept;
+		bool Enabled() noexcept;
+
+		PerfCounts Read() noexcept;
+	}
+}
@@ -0,0 +1,99 @@
+#include "PointSpriteRenderer.hpp"
+#include "VertexLayout.hpp"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <cstddef>
+
+using namespace GameEngine;
+
+// GPU layout of a single point, 44 bytes per sprite
+struct PointSpriteRenderer::Vertex
+{
+	glm::vec3		position;
+	glm::vec2		size;
+	float			rotation;
+	glm::vec4		uvRect;
+	std::uint32_t	tint;
+
+	using Layout = VertexLayout<
+		VertexAttribute<float, 3>,
+		VertexAttribute<float, 2>,
+		VertexAttribute<float, 1>,
+		VertexAttribute<float, 4>,
+		VertexAttribute<std::uint8_t, 4, AttributeMode::Normalized>>;
+};
+
+
+//						[CONSTRUCTORS]
+
+PointSpriteRenderer::PointSpriteRenderer(const std::string& shaderPath)
+	: m_Shader{ shaderPath + "spritePoint.vert", shaderPath + "spritePoint.geom", shaderPath + "sprite.frag" }
+{
+	static_assert(sizeof(Vertex) == 44 && Vertex::Layout::stride == 44, "PointSpriteRenderer.Vertex must be tightly packed");
+
+	glGenVertexArrays(1, &m_VAO);
+	glBindVertexArray(m_VAO);
+
+	glGenBuffers(1, &m_VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+	Vertex::Layout::Apply();
+	glBindVertexArray(0);
+
+	m_Shader.Use();
+	m_Shader.SetInt("spriteTexture", 0);
+	m_Shader.SetInt("spritePalette", paletteTextureUnit);
+}
+
+PointSpriteRenderer::~PointSpriteRenderer()
+{
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteProgram(m_Shader.GetID());
+}
+
+
+//						[UTILITY]
+
+void PointSpriteRenderer::Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection)
+{
+	if (sprites.empty())
+		return;
+
+	m_Vertices.clear();
+	m_Vertices.reserve(sprites.size());
+	for (const Sprite& sprite : sprites)
+		m_Vertices.push_back({ sprite.position, sprite.size, sprite.rotation, sprite.uvRect, sprite.tint });
+
+	const std::size_t bytes{ m_Vertices.size() * sizeof(Vertex) };
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	if (sprites.size() > m_Capacity)
+	{
+		m_Capacity = sprites.size();
+		glBufferData(GL_ARRAY_BUFFER, bytes, m_Vertices.data(), GL_STREAM_DRAW);
+	}
+	else
+	{
+		// Orphaning the storage lets the driver hand out a fresh block
+		// instead of waiting for the previous frame to finish reading it
+		glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_Vertices.data());
+	}
+
+	m_Shader.Use();
+	m_Shader.SetMat4f("view", glm::value_ptr(view));
+	m_Shader.SetMat4f("projection", glm::value_ptr(projection));
+	m_Shader.SetFloat("alphaCutoff", m_AlphaCutoff);
+	m_Shader.SetBool("paletteMode", m_PaletteMode);
+
+	glBindVertexArray(m_VAO);
+	glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(sprites.size()));
+	glBindVertexArray(0);
+
+	m_Stats.drawCalls += 1;
+	m_Stats.sprites += sprites.size();
+	m_Stats.vertices += sprites.size();
+	m_Stats.bytesUploaded += bytes;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "SpriteRenderer.hpp"
+#include "Shader.hpp"
+#include <vector>
+
+namespace GameEngine
+{
+	// Every sprite is streamed as a single point carrying all of its attributes,
+	// the geometry shader expands the point into a quad.
+	// One vertex per sprite instead of four (plus indices) for the quad approach
+	class PointSpriteRenderer final : public SpriteRenderer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		explicit PointSpriteRenderer(const std::string& shaderPath);
+		~PointSpriteRenderer() override;
+
+
+		//				[GETTERS]
+
+		SpriteBackend Backend() const noexcept override { return SpriteBackend::PointSprite; }
+
+
+		//				[UTILITY]
+
+		void Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection) override;
+
+	private:
+		struct Vertex;
+
+		Shader m_Shader;
+		unsigned int m_VAO{};
+		unsigned int m_VBO{};
+		std::size_t m_Capacity{};	// in sprites
+		std::vector<Vertex> m_Vertices;
+	};
+}
@@ -0,0 +1,89 @@
+#include "ProfilerOverlay.hpp"
+
+#include <algorithm>
+#include <format>
+
+using namespace GameEngine;
+
+static constexpr float rowHeight{ 10.0f };
+static constexpr float rowGap{ 3.0f };
+static constexpr float indentWidth{ 8.0f };
+
+// Draws a single timing row, returns the y of the next one
+static float DrawTimingRow(Overlay& overlay, const GpuPassTiming& timing, double budgetMs, float x, float y, float width)
+{
+	const float indent{ indentWidth * static_cast<float>(timing.depth) };
+	const float barWidth{ width - indent };
+	auto toPixels = [budgetMs, barWidth](double ms)
+	{
+		return static_cast<float>(std::min(ms / budgetMs, 1.0)) * barWidth;
+	};
+
+	const std::uint32_t color{ timing.averageMs > budgetMs ? PackColor(230, 60, 50, 220) : PackColor(80, 200, 90, 220) };
+
+	overlay.Rect(x + indent, y, barWidth, rowHeight, PackColor(0, 0, 0, 140));
+	overlay.Rect(x + indent, y, toPixels(timing.averageMs), rowHeight, color);
+	overlay.Rect(x + indent + std::max(toPixels(timing.maxMs) - 2.0f, 0.0f), y, 2.0f, rowHeight, PackColor(255, 220, 60));
+
+	return y + rowHeight + rowGap;
+}
+
+void GameEngine::DrawGpuProfile(Overlay& overlay, const GpuProfiler& profiler, double budgetMs, float x, float y, float width)
+{
+	y = DrawTimingRow(overlay, profiler.Frame(), budgetMs, x, y, width);
+	for (const GpuPassTiming& pass : profiler.Passes())
+		y = DrawTimingRow(overlay, pass, budgetMs, x, y, width);
+}
+
+std::string GameEngine::FormatGpuProfile(const GpuProfiler& profiler)
+{
+	std::string text{ std::format("frame {:.2f} ms", profiler.Frame().averageMs) };
+	for (const GpuPassTiming& pass : profiler.Passes())
+		text += std::format(" | {} {:.2f}", pass.name, pass.averageMs);
+
+	return text;
+}
+
+void GameEngine::DrawFrameStats(Overlay& overlay, const FrameStats& stats, float x, float y, float width, float height)
+{
+	constexpr float barWidth{ 2.0f };
+	const double budgetMs{ stats.BudgetMs() };
+
+	overlay.Rect(x, y, width, height, PackColor(0, 0, 0, 140));
+
+	// Newest frames on the right
+	const std::vector<double> recent{ stats.Recent() };
+	const std::size_t shown{ std::min(recent.size(), static_cast<std::size_t>(width / barWidth)) };
+	for (std::size_t i = 0; i < shown; ++i)
+	{
+		const double ms{ recent[recent.size() - shown + i] };
+		const float barHeight{ static_cast<float>(std::min(ms / (budgetMs * 2.0), 1.0)) * height };
+		const std::uint32_t color{ ms > budgetMs * 2.0 ? PackColor(230, 60, 50, 230)
+			: ms > budgetMs ? PackColor(240, 200, 60, 230) : PackColor(80, 200, 90, 230) };
+
+		overlay.Rect(x + width - static_cast<float>(shown - i) * barWidth, y + height - barHeight, barWidth, barHeight, color);
+	}
+	overlay.Rect(x, y + height * 0.5f, width, 1.0f, PackColor(255, 255, 255, 160));
+
+	// Histogram, linear in counts
+	const float histogramY{ y + height + rowGap };
+	const auto& histogram = stats.Histogram();
+	const std::uint64_t highest{ std::max<std::uint64_t>(*std::max_element(histogram.begin(), histogram.end()), 1) };
+	const float bucketWidth{ width / static_cast<float>(FrameStats::bucketCount) };
+
+	overlay.Rect(x, histogramY, width, height * 0.5f, PackColor(0, 0, 0, 140));
+	for (std::size_t bucket = 0; bucket < FrameStats::bucketCount; ++bucket)
+	{
+		const float barHeight{ static_cast<float>(histogram[bucket]) / static_cast<float>(highest) * height * 0.5f };
+		const std::uint32_t color{ FrameStats::BucketStartMs(bucket) >= budgetMs ? PackColor(230, 60, 50, 230) : PackColor(90, 160, 230, 230) };
+
+		overlay.Rect(x + static_cast<float>(bucket) * bucketWidth, histogramY + height * 0.5f - barHeight, std::max(bucketWidth - 1.0f, 1.0f), barHeight, color);
+	}
+}
+
+std::string GameEngine::FormatFrameStats(const FrameStats& stats)
+{
+	const FrameStatsSummary summary{ stats.Summary() };
+	return std::format("p50 {:.1f} | p99 {:.1f} | 1% low {:.0f} FPS | hitches {}",
+		summary.p50Ms, summary.p99Ms, summary.onePercentLowFps, stats.TotalHitches());
+}
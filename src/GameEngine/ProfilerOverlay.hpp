@@ -0,0 +1,22 @@
+#pragma once
+#include "Overlay.hpp"
+#include "GpuProfiler.hpp"
+#include "FrameStats.hpp"
+#include <string>
+
+namespace GameEngine
+{
+	// One row per GPU scope at (x, y): a bar of the average time with a marker at the
+	// maximum, scaled so the whole width is the frame budget. Over-budget rows turn red
+	void DrawGpuProfile(Overlay& overlay, const GpuProfiler& profiler, double budgetMs, float x, float y, float width = 300.0f);
+
+	// "frame 4.21 ms | scene 3.10 | upscale 0.40" for the window title or a log
+	std::string FormatGpuProfile(const GpuProfiler& profiler);
+
+	// Graph of the recent frame times (the top of the graph is twice the budget) with
+	// the budget line, and the session histogram below it. Both take width x height
+	void DrawFrameStats(Overlay& overlay, const FrameStats& stats, float x, float y, float width = 300.0f, float height = 80.0f);
+
+	// "p50 16.6 | p99 18.2 | 1% low 52 FPS | hitches 3"
+	std::string FormatFrameStats(const FrameStats& stats);
+}
@@ -0,0 +1,93 @@
+#include "QuadSpriteRenderer.hpp"
+#include "VertexLayout.hpp"
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+QuadSpriteRenderer::QuadSpriteRenderer(const std::string& shaderPath)
+	: m_Shader{ shaderPath + "spriteQuad.vert", shaderPath + "sprite.frag" }
+{
+	constexpr float quad[] =
+	{
+		-0.5f,  0.5f, 0.0f, 0.0f, 1.0f,
+		 0.5f,  0.5f, 0.0f, 1.0f, 1.0f,
+		 0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
+		-0.5f, -0.5f, 0.0f, 0.0f, 0.0f
+	};
+
+	constexpr unsigned int indices[] =
+	{
+		0, 1, 2,
+		2, 3, 0
+	};
+
+	glGenVertexArrays(1, &m_VAO);
+	glBindVertexArray(m_VAO);
+
+	glGenBuffers(1, &m_VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+	glGenBuffers(1, &m_EBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+	// xyz + uv
+	VertexLayout<VertexAttribute<float, 3>, VertexAttribute<float, 2>>::Apply();
+	glBindVertexArray(0);
+
+	m_Shader.Use();
+	m_Shader.SetInt("spriteTexture", 0);
+	m_Shader.SetInt("spritePalette", paletteTextureUnit);
+}
+
+QuadSpriteRenderer::~QuadSpriteRenderer()
+{
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteBuffers(1, &m_EBO);
+	glDeleteProgram(m_Shader.GetID());
+}
+
+
+//						[UTILITY]
+
+void QuadSpriteRenderer::Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection)
+{
+	m_Shader.Use();
+	m_Shader.SetMat4f("view", glm::value_ptr(view));
+	m_Shader.SetMat4f("projection", glm::value_ptr(projection));
+	m_Shader.SetFloat("alphaCutoff", m_AlphaCutoff);
+	m_Shader.SetBool("paletteMode", m_PaletteMode);
+
+	glBindVertexArray(m_VAO);
+	for (const Sprite& sprite : sprites)
+	{
+		glm::mat4 model{ 1.0f };
+		model = glm::translate(model, sprite.position);
+		model = glm::rotate(model, sprite.rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+		model = glm::scale(model, glm::vec3{ sprite.size, 1.0f });
+
+		m_Shader.SetMat4f("model", glm::value_ptr(model));
+		m_Shader.SetFloat4("uvRect", sprite.uvRect.x, sprite.uvRect.y, sprite.uvRect.z, sprite.uvRect.w);
+		m_Shader.SetFloat4("tint",
+			static_cast<float>(sprite.tint & 0xFF) / 255.0f,
+			static_cast<float>((sprite.tint >> 8) & 0xFF) / 255.0f,
+			static_cast<float>((sprite.tint >> 16) & 0xFF) / 255.0f,
+			static_cast<float>(sprite.tint >> 24) / 255.0f);
+
+		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+	}
+	glBindVertexArray(0);
+
+	m_Stats.drawCalls += sprites.size();
+	m_Stats.sprites += sprites.size();
+	m_Stats.vertices += sprites.size() * 4;
+	m_Stats.bytesUploaded += sprites.size() * (sizeof(glm::mat4) + 2 * sizeof(glm::vec4));
+}
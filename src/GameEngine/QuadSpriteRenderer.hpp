@@ -0,0 +1,33 @@
+#pragma once
+#include "SpriteRenderer.hpp"
+#include "Shader.hpp"
+
+namespace GameEngine
+{
+	// Reference backend: the indexed unit quad is drawn once per sprite
+	// with its own model matrix, UV rectangle and tint uniforms
+	class QuadSpriteRenderer final : public SpriteRenderer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		explicit QuadSpriteRenderer(const std::string& shaderPath);
+		~QuadSpriteRenderer() override;
+
+
+		//				[GETTERS]
+
+		SpriteBackend Backend() const noexcept override { return SpriteBackend::Quad; }
+
+
+		//				[UTILITY]
+
+		void Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection) override;
+
+	private:
+		Shader m_Shader;
+		unsigned int m_VAO{};
+		unsigned int m_VBO{};
+		unsigned int m_EBO{};
+	};
+}
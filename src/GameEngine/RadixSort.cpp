@@ -0,0 +1,111 @@
+#include "RadixSort.hpp"
+#include "CpuProfiler.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+template <typename TKey>
+void RadixSorter<TKey>::Sort(std::span<TKey> keys, std::span<std::uint32_t> values, JobSystem* jobs)
+{
+	PROFILE_ZONE("RadixSort");
+
+	if (keys.size() != values.size())
+		throw std::runtime_error{ "RadixSorter.Sort error: keys and values differ in size\n" };
+
+	const std::size_t count{ keys.size() };
+	if (count < 2)
+		return;
+
+	m_KeyScratch.resize(count);
+	m_ValueScratch.resize(count);
+
+	const bool parallel{ jobs != nullptr && jobs->WorkerCount() > 0 && count >= parallelThreshold };
+	const std::size_t chunkCount{ parallel ? jobs->WorkerCount() + 1 : 1 };
+
+	// A single read of the keys gives the digit totals of every pass
+	std::size_t totals[passCount][radix]{};
+	for (TKey key : keys)
+	{
+		for (std::size_t pass = 0; pass < passCount; ++pass)
+			++totals[pass][(key >> (pass * 8)) & 0xFF];
+	}
+
+	TKey* sourceKeys = keys.data();
+	std::uint32_t* sourceValues = values.data();
+	TKey* targetKeys = m_KeyScratch.data();
+	std::uint32_t* targetValues = m_ValueScratch.data();
+
+	for (std::size_t pass = 0; pass < passCount; ++pass)
+	{
+		const std::size_t shift{ pass * 8 };
+
+		if (std::find(std::begin(totals[pass]), std::end(totals[pass]), count) != std::end(totals[pass]))
+			continue;
+
+		if (!parallel)
+		{
+			std::size_t offsets[radix]{};
+			for (std::size_t digit = 1; digit < radix; ++digit)
+				offsets[digit] = offsets[digit - 1] + totals[pass][digit - 1];
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const std::size_t target{ offsets[(sourceKeys[i] >> shift) & 0xFF]++ };
+				targetKeys[target] = sourceKeys[i];
+				targetValues[target] = sourceValues[i];
+			}
+		}
+		else
+		{
+			// Each chunk counts its own digits, then scatters into the slots that
+			// precede the same digits of the later chunks, which keeps the sort stable
+			m_Histograms.assign(chunkCount * radix, 0);
+
+			jobs->ParallelFor(count, chunkCount, [&](std::size_t begin, std::size_t end, std::size_t chunk)
+			{
+				std::size_t* histogram = m_Histograms.data() + chunk * radix;
+				for (std::size_t i = begin; i < end; ++i)
+					++histogram[(sourceKeys[i] >> shift) & 0xFF];
+			});
+
+			std::size_t offset{};
+			for (std::size_t digit = 0; digit < radix; ++digit)
+			{
+				for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+				{
+					std::size_t& slot = m_Histograms[chunk * radix + digit];
+					const std::size_t digitCount{ slot };
+					slot = offset;
+					offset += digitCount;
+				}
+			}
+
+			jobs->ParallelFor(count, chunkCount, [&](std::size_t begin, std::size_t end, std::size_t chunk)
+			{
+				std::size_t* offsets = m_Histograms.data() + chunk * radix;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const std::size_t target{ offsets[(sourceKeys[i] >> shift) & 0xFF]++ };
+					targetKeys[target] = sourceKeys[i];
+					targetValues[target] = sourceValues[i];
+				}
+			});
+		}
+
+		std::swap(sourceKeys, targetKeys);
+		std::swap(sourceValues, targetValues);
+	}
+
+	// After an odd number of passes the result sits in the scratch buffers
+	if (sourceKeys != keys.data())
+	{
+		std::copy(sourceKeys, sourceKeys + count, keys.data());
+		std::copy(sourceValues, sourceValues + count, values.data());
+	}
+}
+
+template class GameEngine::RadixSorter<std::uint32_t>;
+template class GameEngine::RadixSorter<std::uint64_t>;
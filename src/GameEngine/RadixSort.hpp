@@ -0,0 +1,48 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace GameEngine
+{
+	class JobSystem;
+
+	// Maps the float onto an unsigned integer with the same ordering
+	constexpr std::uint32_t OrderedFloatBits(float value) noexcept
+	{
+		const std::uint32_t bits{ std::bit_cast<std::uint32_t>(value) };
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+
+	// Stable LSD radix sort with 8-bit digits for 32 and 64-bit keys.
+	// Passes in which every key has the same digit are skipped, so keys with
+	// constant high bits (a single layer) cost proportionally less.
+	// Keeps its scratch buffers between calls to avoid per-frame allocations
+	template <typename TKey>
+	class RadixSorter
+	{
+		static_assert(std::is_same_v<TKey, std::uint32_t> || std::is_same_v<TKey, std::uint64_t>, "RadixSorter: 32 or 64-bit unsigned keys only");
+
+	public:
+		// Below that amount of keys the threading overhead is not worth it
+		static constexpr std::size_t parallelThreshold{ 32768 };
+
+		// Sorts the keys ascending and moves the values along with them.
+		// With a job system and enough keys every pass is split across the workers
+		void Sort(std::span<TKey> keys, std::span<std::uint32_t> values, JobSystem* jobs = nullptr);
+
+	private:
+		static constexpr std::size_t passCount{ sizeof(TKey) };
+		static constexpr std::size_t radix{ 256 };
+
+		std::vector<TKey> m_KeyScratch;
+		std::vector<std::uint32_t> m_ValueScratch;
+		std::vector<std::size_t> m_Histograms;		// [chunk][digit]
+	};
+
+	extern template class RadixSorter<std::uint32_t>;
+	extern template class RadixSorter<std::uint64_t>;
+}
@@ -0,0 +1,85 @@
+#include "RenderTarget.hpp"
+#include "Renderer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+//						[CONSTRUCTORS]
+
+RenderTarget::RenderTarget(int width, int height, GLint filter)
+	: m_Width{ width }, m_Height{ height }, m_Filter{ filter }
+{
+	if (width <= 0 || height <= 0)
+		throw std::runtime_error("RenderTarget.RenderTarget error: size has to be positive");
+
+	glGenFramebuffers(1, &m_FBO);
+	glGenTextures(1, &m_Color);
+	glGenRenderbuffers(1, &m_Depth);
+	Allocate();
+}
+
+RenderTarget::~RenderTarget()
+{
+	glDeleteFramebuffers(1, &m_FBO);
+	glDeleteTextures(1, &m_Color);
+	glDeleteRenderbuffers(1, &m_Depth);
+}
+
+
+//						[UTILITY]
+
+void RenderTarget::Resize(int width, int height)
+{
+	if (width <= 0 || height <= 0)
+		throw std::runtime_error("RenderTarget.Resize error: size has to be positive");
+
+	if (width == m_Width && height == m_Height)
+		return;
+
+	m_Width = width;
+	m_Height = height;
+	Allocate();
+}
+
+void RenderTarget::Bind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+	glViewport(0, 0, m_Width, m_Height);
+}
+
+void RenderTarget::BlitToScreen(int x0, int y0, int x1, int y1, GLenum filter) const
+{
+	BlitToScreen(m_Width, m_Height, x0, y0, x1, y1, filter);
+}
+
+void RenderTarget::BlitToScreen(int sourceWidth, int sourceHeight, int x0, int y0, int x1, int y1, GLenum filter) const
+{
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_FBO);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, Renderer::OutputFramebuffer());
+	glBlitFramebuffer(0, 0, std::min(sourceWidth, m_Width), std::min(sourceHeight, m_Height), x0, y0, x1, y1, GL_COLOR_BUFFER_BIT, filter);
+	Renderer::BindOutputFramebuffer();
+}
+
+void RenderTarget::Allocate()
+{
+	glBindTexture(GL_TEXTURE_2D, m_Color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_Filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_Filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, m_Depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Width, m_Height);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_Color, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_Depth);
+	const GLenum status{ glCheckFramebufferStatus(GL_FRAMEBUFFER) };
+	Renderer::BindOutputFramebuffer();
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+		throw std::runtime_error("RenderTarget.Allocate error: framebuffer is incomplete");
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <glad/glad.h>
+
+namespace GameEngine
+{
+	// Offscreen framebuffer with an RGBA8 color texture and a depth/stencil renderbuffer
+	class RenderTarget
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		RenderTarget(int width, int height, GLint filter = GL_NEAREST);
+		~RenderTarget();
+
+		RenderTarget(const RenderTarget&) = delete;
+		RenderTarget& operator=(const RenderTarget&) = delete;
+
+
+		//				[GETTERS]
+
+		int Width() const noexcept { return m_Width; }
+		int Height() const noexcept { return m_Height; }
+		unsigned int ColorTexture() const noexcept { return m_Color; }
+		unsigned int Framebuffer() const noexcept { return m_FBO; }
+
+
+		//				[UTILITY]
+
+		// Reallocates the attachments, does nothing when the size is the same
+		// Exceptions: [runtime_error]
+		void Resize(int width, int height);
+
+		// Binds the framebuffer and sets the viewport to cover it
+		void Bind() const;
+
+		// Copies the color attachment into the given rectangle of the default framebuffer
+		void BlitToScreen(int x0, int y0, int x1, int y1, GLenum filter = GL_NEAREST) const;
+
+		// Same for the bottom-left sourceWidth x sourceHeight part of the target
+		void BlitToScreen(int sourceWidth, int sourceHeight, int x0, int y0, int x1, int y1, GLenum filter) const;
+
+	private:
+		unsigned int m_FBO{};
+		unsigned int m_Color{};
+		unsigned int m_Depth{};
+		int m_Width{};
+		int m_Height{};
+		GLint m_Filter{};
+
+		void Allocate();
+	};
+}
@@ -0,0 +1,101 @@
+#include "Renderer.hpp"
+
+#include <glad/glad.h>
+
+using namespace GameEngine;
+
+static Renderer::DepthMode depthMode{ Renderer::DepthMode::Depth3D };
+static unsigned int outputFramebuffer{};
+
+void Renderer::SetDepthMode(DepthMode mode)
+{
+	depthMode = mode;
+
+	if (mode == DepthMode::Painter2D)
+		glDisable(GL_DEPTH_TEST);
+	else
+		glEnable(GL_DEPTH_TEST);
+
+	glDepthMask(GL_TRUE);
+}
+
+Renderer::DepthMode Renderer::GetDepthMode() noexcept
+{
+	return depthMode;
+}
+
+const char* Renderer::ToString(DepthMode mode) noexcept
+{
+	switch (mode)
+	{
+	case DepthMode::Depth3D:		return "3d";
+	case DepthMode::Painter2D:		return "painter";
+	case DepthMode::SplitPasses:	return "split";
+	}
+
+	return "unknown";
+}
+
+std::optional<Renderer::DepthMode> Renderer::ParseDepthMode(const std::string& name) noexcept
+{
+	for (DepthMode mode : { DepthMode::Depth3D, DepthMode::Painter2D, DepthMode::SplitPasses })
+	{
+		if (name == ToString(mode))
+			return mode;
+	}
+
+	return std::nullopt;
+}
+
+void Renderer::Clear()
+{
+	if (depthMode == DepthMode::Depth3D)
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+	else if (depthMode == DepthMode::SplitPasses)
+	{
+		// Depth writes are off after the translucent pass and would block the clear
+		glDepthMask(GL_TRUE);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+	else
+		glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void Renderer::BeginOpaquePass()
+{
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+	glDisable(GL_BLEND);
+}
+
+void Renderer::BeginTranslucentPass(bool premultipliedAlpha)
+{
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_BLEND);
+	glBlendFunc(premultipliedAlpha ? GL_ONE : GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void Renderer::EndPasses()
+{
+	glDepthMask(GL_TRUE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void Renderer::SetOutputFramebuffer(unsigned int framebuffer) noexcept
+{
+	outputFramebuffer = framebuffer;
+}
+
+unsigned int Renderer::OutputFramebuffer() noexcept
+{
+	return outputFramebuffer;
+}
+
+void Renderer::BindOutputFramebuffer()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, outputFramebuffer);
+}
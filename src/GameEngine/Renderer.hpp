@@ -1 +1,40 @@
-#pragma once
\ No newline at end of file
+#pragma once
+#include <optional>
+#include <string>
+
+namespace GameEngine::Renderer
+{
+	// How the scene resolves overlapping geometry
+	enum class DepthMode
+	{
+		Depth3D,		// depth test on, depth buffer cleared every frame
+		Painter2D,		// no depth test and no depth clears, the draw order decides (see SpriteQueue)
+		SplitPasses,	// opaque/cutout front to back with depth writes, then blended translucent back to front
+	};
+
+	void SetDepthMode(DepthMode mode);
+	DepthMode GetDepthMode() noexcept;
+
+	// "3d", "painter" and "split", for the command lines and reports
+	const char* ToString(DepthMode mode) noexcept;
+	std::optional<DepthMode> ParseDepthMode(const std::string& name) noexcept;
+
+	// Clears the color buffer, plus depth and stencil when the depth mode needs them
+	void Clear();
+
+	// SplitPasses: depth test and writes on, blending off
+	void BeginOpaquePass();
+
+	// SplitPasses: depth test on, depth writes off, alpha blending on.
+	// Premultiplied textures (see CookedTexture) blend with GL_ONE as the source factor
+	void BeginTranslucentPass(bool premultipliedAlpha = false);
+
+	// SplitPasses: back to the state the passes started from, depth writes on and straight alpha blending
+	void EndPasses();
+
+	// Framebuffer that stands for the screen: 0 with a window, the offscreen target of a headless context.
+	// Everything that presents to the screen binds this one instead of 0
+	void SetOutputFramebuffer(unsigned int framebuffer) noexcept;
+	unsigned int OutputFramebuffer() noexcept;
+	void BindOutputFramebuffer();
+}
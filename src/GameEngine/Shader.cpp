@@ -1,4 +1,6 @@
 #include "Shader.hpp"
+#include "AssetPack.hpp"
+#include "CpuProfiler.hpp"
 
 #include <glad/glad.h>
 #include <glfw3.h>
@@ -10,85 +12,141 @@
 
 using namespace GameEngine;
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+static constexpr int infoLogBufSize{ 512 };
+
+// Deletes the compiled stage when it goes out of scope, linked programs keep their own reference
+struct ShaderStage
 {
-	constexpr int infoLogBufSize{ 512 };
+	unsigned int id{};
+
+	ShaderStage(unsigned int stage) : id{ stage } {}
+	~ShaderStage() { if (id != 0) glDeleteShader(id); }
 
-	std::string vertexCode;
-	std::string fragmentCode;
-	
+	ShaderStage(const ShaderStage&) = delete;
+	ShaderStage& operator=(const ShaderStage&) = delete;
+};
 
+// Reads the whole shader file into a string
+// Exceptions: [runtime_error]
+static std::string ReadShaderFile(const std::string& path)
+{
 	try
 	{
-		
-		std::ifstream vertexFileStream;
-		std::ifstream fragmentFileStream;
-		vertexFileStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-		fragmentFileStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-		vertexFileStream.open(vertexPath);
-		fragmentFileStream.open(fragmentPath);
-
-		std::stringstream vertexStringStream;
-		std::stringstream fragmentStringStream;
+		std::ifstream fileStream;
+		fileStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+		fileStream.open(path);
 
-		vertexStringStream << vertexFileStream.rdbuf();
-		fragmentStringStream << fragmentFileStream.rdbuf();
+		std::stringstream stringStream;
+		stringStream << fileStream.rdbuf();
 
-		vertexCode = vertexStringStream.str();
-		fragmentCode = fragmentStringStream.str();
-
-		vertexFileStream.close();
-		fragmentFileStream.close();
+		return stringStream.str();
 	}
 	catch (const std::ios_base::failure&)
 	{
 		throw std::runtime_error("Shader.Shader error: can't open shader files");
 	}
+}
 
-	const char* vertShaderCode = vertexCode.c_str();
-	const char* fragShaderCode = fragmentCode.c_str();
-	unsigned int vertex{};
-	unsigned int fragment{};
+// Compiles a single shader stage, stageName is used only for the error message
+// Exceptions: [runtime_error]
+static unsigned int CompileStage(GLenum type, std::string_view code, const char* stageName)
+{
+	// Passing the length lets the code come straight from a mapped file without a terminating zero
+	const char* shaderCode = code.data();
+	const int shaderLength = static_cast<int>(code.size());
 	int success{};
 	char infoLog[infoLogBufSize]{};
 
-	vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertex, 1, &vertShaderCode, nullptr);
-	glCompileShader(vertex);
-	glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
+	unsigned int stage = glCreateShader(type);
+	glShaderSource(stage, 1, &shaderCode, &shaderLength);
+	glCompileShader(stage);
+	glGetShaderiv(stage, GL_COMPILE_STATUS, &success);
 	if (!success)
 	{
-		glGetShaderInfoLog(vertex, infoLogBufSize, nullptr, infoLog);
-		std::string error = std::format("Shader.Shader error: vertex shader has not successful compiled:\n{}", infoLog);
+		glGetShaderInfoLog(stage, infoLogBufSize, nullptr, infoLog);
+		glDeleteShader(stage);
+		std::string error = std::format("Shader.Shader error: {} shader has not successful compiled:\n{}", stageName, infoLog);
 		throw std::runtime_error(error);
 	}
 
-	fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragment, 1, &fragShaderCode, nullptr);
-	glCompileShader(fragment);
-	glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(fragment, infoLogBufSize, nullptr, infoLog);
-		std::string error = std::format("Shader.Shader error: fragment shader has not successful compiled:\n{}", infoLog);
-		throw std::runtime_error(error);
-	}
+	return stage;
+}
+
+// Links the stages into the program, geometry stage is optional (zero)
+// Exceptions: [runtime_error]
+static unsigned int LinkProgram(unsigned int vertex, unsigned int geometry, unsigned int fragment)
+{
+	int success{};
+	char infoLog[infoLogBufSize]{};
 
-	ID = glCreateProgram();
-	glAttachShader(ID, vertex);
-	glAttachShader(ID, fragment);
-	glLinkProgram(ID);
-	glGetProgramiv(ID, GL_COMPILE_STATUS, &success);
+	unsigned int program = glCreateProgram();
+	glAttachShader(program, vertex);
+	if (geometry != 0)
+		glAttachShader(program, geometry);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
 	if (!success)
 	{
-		glGetProgramInfoLog(ID, infoLogBufSize, nullptr, infoLog);
+		glGetProgramInfoLog(program, infoLogBufSize, nullptr, infoLog);
+		glDeleteProgram(program);
 		std::string error = std::format("Shader.Shader error: shader program has not successful compiled:\n{}", infoLog);
 		throw std::runtime_error(error);
 	}
 
-	glDeleteShader(vertex);
-	glDeleteShader(fragment);
+	return program;
+}
+
+// Compiles the stages and links them, an empty geometry code means there is no geometry stage
+// Exceptions: [runtime_error]
+static unsigned int BuildProgram(std::string_view name, std::string_view vertexCode, std::string_view geometryCode, std::string_view fragmentCode)
+{
+	PROFILE_ZONE("Shader compile");
+	PROFILE_MARKER("Shader compile", std::string{ name });
+
+	// The stages compiled so far are deleted on every way out, errors included
+	const ShaderStage vertex{ CompileStage(GL_VERTEX_SHADER, vertexCode, "vertex") };
+	const ShaderStage geometry{ geometryCode.empty() ? 0 : CompileStage(GL_GEOMETRY_SHADER, geometryCode, "geometry") };
+	const ShaderStage fragment{ CompileStage(GL_FRAGMENT_SHADER, fragmentCode, "fragment") };
+
+	return LinkProgram(vertex.id, geometry.id, fragment.id);
+}
+
+ShaderSources GameEngine::ReadShaderSources(const std::string& vertexPath, const std::string& fragmentPath)
+{
+	return { vertexPath + " + " + fragmentPath, ReadShaderFile(vertexPath), {}, ReadShaderFile(fragmentPath) };
+}
+
+ShaderSources GameEngine::ReadShaderSources(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath)
+{
+	return { vertexPath + " + " + geometryPath + " + " + fragmentPath,
+		ReadShaderFile(vertexPath), ReadShaderFile(geometryPath), ReadShaderFile(fragmentPath) };
+}
+
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+	: Shader(ReadShaderSources(vertexPath, fragmentPath))
+{
+}
+
+// Geometry stage sits between the vertex and fragment ones (e.g. point sprite expansion)
+Shader::Shader(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath)
+	: Shader(ReadShaderSources(vertexPath, geometryPath, fragmentPath))
+{
+}
+
+Shader::Shader(const ShaderSources& sources)
+	: ID{ BuildProgram(sources.name, sources.vertex, sources.geometry, sources.fragment) }
+{
+}
+
+Shader::Shader(const AssetPack& pack, std::string_view vertexName, std::string_view fragmentName)
+	: ID{ BuildProgram(vertexName, pack.Text(vertexName), {}, pack.Text(fragmentName)) }
+{
+}
+
+Shader::Shader(const AssetPack& pack, std::string_view vertexName, std::string_view geometryName, std::string_view fragmentName)
+	: ID{ BuildProgram(vertexName, pack.Text(vertexName), pack.Text(geometryName), pack.Text(fragmentName)) }
+{
 }
 
 void Shader::Use() const
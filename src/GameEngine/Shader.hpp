@@ -1,12 +1,39 @@
 #pragma once
 #include <string>
+#include <string_view>
 
 namespace GameEngine
 {
+	// Shader files read into memory, this part needs no GL context and can run on a worker thread.
+	// An empty geometry stage means there is none
+	struct ShaderSources
+	{
+		std::string name;
+		std::string vertex;
+		std::string geometry;
+		std::string fragment;
+	};
+
+	// Exceptions: [runtime_error]
+	ShaderSources ReadShaderSources(const std::string& vertexPath, const std::string& fragmentPath);
+	ShaderSources ReadShaderSources(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath);
+
+	class AssetPack;
+
 	class Shader
 	{
 	public:
 		Shader(const std::string& vertexPath, const std::string& fragmentPath);
+		Shader(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath);
+
+		// Compiles and links already read sources
+		// Exceptions: [runtime_error]
+		explicit Shader(const ShaderSources& sources);
+
+		// Compiles the sources in place from the pack mapping, no copies
+		// Exceptions: [runtime_error]
+		Shader(const AssetPack& pack, std::string_view vertexName, std::string_view fragmentName);
+		Shader(const AssetPack& pack, std::string_view vertexName, std::string_view geometryName, std::string_view fragmentName);
 
 		void Use() const;
 
@@ -0,0 +1,31 @@
+#pragma once
+#include "SpriteOutline.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace GameEngine
+{
+	// Packs the color into RGBA8 (red in the lowest byte)
+	constexpr std::uint32_t PackColor(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255) noexcept
+	{
+		return static_cast<std::uint32_t>(r)
+			| (static_cast<std::uint32_t>(g) << 8)
+			| (static_cast<std::uint32_t>(b) << 16)
+			| (static_cast<std::uint32_t>(a) << 24);
+	}
+
+	// CPU-side description of a single sprite.
+	// Every renderer backend translates it into its own GPU format
+	struct Sprite
+	{
+		glm::vec3		position{};								// center of the sprite, z is the depth
+		glm::vec2		size{ 1.0f };							// width and height in world units
+		float			rotation{};								// angle in radians (!) around the z axis
+		glm::vec4		uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };		// [u0; v0; u1; v1] in the bound texture
+		std::uint32_t	tint{ PackColor(255, 255, 255) };		// RGBA8 color multiplier
+
+		// Trimmed polygon of the frame (see SpriteSheet), drawn instead of the quad
+		// by the batching backends. Others, or nullptr, draw the full quad
+		const SpriteOutline* outline{ nullptr };
+	};
+}
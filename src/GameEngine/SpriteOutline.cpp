@@ -0,0 +1,164 @@
+#include "SpriteOutline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace GameEngine;
+
+static float Cross(const glm::vec2& a, const glm::vec2& b) noexcept
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+static float PolygonArea(const glm::vec2* points, std::size_t count) noexcept
+{
+	float area{};
+	for (std::size_t i = 0; i < count; ++i)
+		area += Cross(points[i], points[(i + 1) % count]);
+
+	return std::abs(area) * 0.5f;
+}
+
+// Andrew's monotone chain, counter-clockwise without collinear points
+static std::vector<glm::vec2> ConvexHull(std::vector<glm::vec2> points)
+{
+	std::sort(points.begin(), points.end(), [](const glm::vec2& a, const glm::vec2& b)
+	{
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+	points.erase(std::unique(points.begin(), points.end()), points.end());
+
+	if (points.size() < 3)
+		return points;
+
+	std::vector<glm::vec2> hull(points.size() * 2);
+	std::size_t size{};
+
+	for (const glm::vec2& point : points)
+	{
+		while (size >= 2 && Cross(hull[size - 1] - hull[size - 2], point - hull[size - 2]) <= 0.0f)
+			--size;
+		hull[size++] = point;
+	}
+
+	const std::size_t lowerSize{ size + 1 };
+	for (auto point = points.rbegin() + 1; point != points.rend(); ++point)
+	{
+		while (size >= lowerSize && Cross(hull[size - 1] - hull[size - 2], *point - hull[size - 2]) <= 0.0f)
+			--size;
+		hull[size++] = *point;
+	}
+
+	hull.resize(size - 1);
+	return hull;
+}
+
+float SpriteOutline::Coverage() const noexcept
+{
+	return count == 0 ? 1.0f : PolygonArea(points.data(), count);
+}
+
+SpriteOutline GameEngine::ComputeSpriteOutline(const unsigned char* pixels, int imageWidth, int x, int y, int width, int height, int maxPoints)
+{
+	maxPoints = std::clamp(maxPoints, 4, SpriteOutline::maxPoints);
+
+	// Only the outer corners of the leftmost and rightmost pixel of every row can be on the hull
+	std::vector<glm::vec2> corners;
+	glm::vec2 boundsMin{ static_cast<float>(width), static_cast<float>(height) };
+	glm::vec2 boundsMax{ 0.0f };
+	for (int row = 0; row < height; ++row)
+	{
+		const unsigned char* line = pixels + (static_cast<std::size_t>(y + row) * imageWidth + x) * 4;
+
+		int left{ -1 };
+		int right{ -1 };
+		for (int column = 0; column < width; ++column)
+		{
+			if (line[column * 4 + 3] == 0)
+				continue;
+
+			if (left < 0)
+				left = column;
+			right = column;
+		}
+
+		if (left < 0)
+			continue;
+
+		const float bottom{ static_cast<float>(row) };
+		const float top{ static_cast<float>(row + 1) };
+		corners.insert(corners.end(), {
+			{ static_cast<float>(left), bottom }, { static_cast<float>(left), top },
+			{ static_cast<float>(right + 1), bottom }, { static_cast<float>(right + 1), top } });
+
+		boundsMin = glm::min(boundsMin, glm::vec2{ static_cast<float>(left), bottom });
+		boundsMax = glm::max(boundsMax, glm::vec2{ static_cast<float>(right + 1), top });
+	}
+
+	// Empty frame keeps the full quad
+	SpriteOutline outline{};
+	if (corners.empty())
+		return outline;
+
+	std::vector<glm::vec2> polygon = ConvexHull(std::move(corners));
+	const glm::vec2 frameSize{ static_cast<float>(width), static_cast<float>(height) };
+
+	while (polygon.size() > static_cast<std::size_t>(maxPoints))
+	{
+		// Removing edge [i; i + 1] extends its neighbours until they meet at the point X
+		std::size_t bestEdge{ polygon.size() };
+		glm::vec2 bestPoint{};
+		float bestArea{ INFINITY };
+
+		const std::size_t count{ polygon.size() };
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const glm::vec2& previous = polygon[(i + count - 1) % count];
+			const glm::vec2& start = polygon[i];
+			const glm::vec2& end = polygon[(i + 1) % count];
+			const glm::vec2& next = polygon[(i + 2) % count];
+
+			const glm::vec2 startDirection{ start - previous };
+			const glm::vec2 endDirection{ end - next };
+			const float denominator{ Cross(startDirection, endDirection) };
+			if (std::abs(denominator) < 1e-6f)
+				continue;
+
+			// start + t * startDirection == end + s * endDirection, both need to go outwards
+			const float t{ Cross(end - start, endDirection) / denominator };
+			const float s{ Cross(end - start, startDirection) / denominator };
+			if (t < 0.0f || s < 0.0f)
+				continue;
+
+			const glm::vec2 point{ start + startDirection * t };
+			if (point.x < 0.0f || point.y < 0.0f || point.x > frameSize.x || point.y > frameSize.y)
+				continue;
+
+			const float area{ std::abs(Cross(point - start, end - start)) * 0.5f };
+			if (area < bestArea)
+			{
+				bestArea = area;
+				bestEdge = i;
+				bestPoint = point;
+			}
+		}
+
+		if (bestEdge == polygon.size())
+			break;
+
+		polygon[bestEdge] = bestPoint;
+		polygon.erase(polygon.begin() + static_cast<std::ptrdiff_t>((bestEdge + 1) % count));
+	}
+
+	// The bounding box of the pixels is the fallback, and it also wins when it is smaller
+	const float boxArea{ (boundsMax.x - boundsMin.x) * (boundsMax.y - boundsMin.y) };
+	if (polygon.size() > static_cast<std::size_t>(maxPoints) || PolygonArea(polygon.data(), polygon.size()) >= boxArea)
+		polygon = { boundsMin, { boundsMax.x, boundsMin.y }, boundsMax, { boundsMin.x, boundsMax.y } };
+
+	outline.count = static_cast<std::uint8_t>(polygon.size());
+	for (std::size_t i = 0; i < polygon.size(); ++i)
+		outline.points[i] = polygon[i] / frameSize;
+
+	return outline;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+
+namespace GameEngine
+{
+	// Convex polygon tightly around the visible pixels of a sprite frame.
+	// Points are counter-clockwise in frame space: [0; 0] is the bottom-left
+	// corner of the frame and [1; 1] the top-right one
+	struct SpriteOutline
+	{
+		static constexpr int maxPoints{ 8 };
+
+		std::array<glm::vec2, maxPoints> points{};
+		std::uint8_t count{};		// zero means the full frame quad
+
+		// Part of the frame quad that the polygon covers
+		float Coverage() const noexcept;
+	};
+
+	// Builds the outline of the frame [x; x + width) x [y; y + height) of RGBA pixels
+	// (bottom row first). The convex hull of the non-transparent pixels is reduced
+	// to at most maxPoints (4 to 8) by cutting off the edges whose removal adds
+	// the least area, the polygon never leaves the frame so the UVs stay inside it
+	SpriteOutline ComputeSpriteOutline(const unsigned char* pixels, int imageWidth, int x, int y, int width, int height, int maxPoints = SpriteOutline::maxPoints);
+}
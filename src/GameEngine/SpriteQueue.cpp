@@ -0,0 +1,118 @@
+#include "SpriteQueue.hpp"
+#include "CpuProfiler.hpp"
+#include "JobSystem.hpp"
+#include "Renderer.hpp"
+#include "SpriteRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace GameEngine;
+
+
+//						[UTILITY]
+
+void SpriteQueue::Clear() noexcept
+{
+	m_Sprites.clear();
+	m_Alpha.clear();
+	m_Keys.clear();
+	m_Submitted = 0;
+}
+
+void SpriteQueue::Submit(const Sprite& sprite, std::uint8_t layer, std::uint32_t subOrder, AlphaClass alpha)
+{
+	++m_Submitted;
+
+	// Radius of the circle around the sprite covers any rotation
+	const float radius{ 0.5f * std::sqrt(sprite.size.x * sprite.size.x + sprite.size.y * sprite.size.y) };
+	if (sprite.position.x + radius < m_VisibleArea.x || sprite.position.x - radius > m_VisibleArea.z
+		|| sprite.position.y + radius < m_VisibleArea.y || sprite.position.y - radius > m_VisibleArea.w)
+		return;
+
+	m_Sprites.push_back(sprite);
+	m_Alpha.push_back(alpha);
+	m_Keys.push_back(MakeSpriteSortKey(layer, sprite.position.y, subOrder));
+}
+
+void SpriteQueue::Sort(JobSystem* jobs)
+{
+	PROFILE_ZONE("SpriteQueue.Sort");
+
+	const std::size_t count{ m_Sprites.size() };
+
+	m_Order.resize(count);
+	std::iota(m_Order.begin(), m_Order.end(), 0u);
+	m_Sorter.Sort(m_Keys, m_Order, jobs);
+
+	m_Sorted.resize(count);
+	auto gather = [this](std::size_t begin, std::size_t end, std::size_t)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			m_Sorted[i] = m_Sprites[m_Order[i]];
+	};
+
+	if (jobs != nullptr && count >= RadixSorter<std::uint64_t>::parallelThreshold)
+		jobs->ParallelFor(count, jobs->WorkerCount() + 1, gather);
+	else
+		gather(0, count, 0);
+
+	if (Renderer::GetDepthMode() != Renderer::DepthMode::SplitPasses)
+		return;
+
+	// Depth follows the painter's order inside [0; 1), later means closer to the camera,
+	// so the opaque pass reversed is front to back and rejects hidden fragments early
+	m_Opaque.clear();
+	m_Translucent.clear();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		Sprite sprite = m_Sorted[i];
+		sprite.position.z = static_cast<float>(i) / static_cast<float>(count);
+
+		if (m_Alpha[m_Order[i]] == AlphaClass::Translucent)
+			m_Translucent.push_back(sprite);
+		else
+			m_Opaque.push_back(sprite);
+	}
+
+	std::reverse(m_Opaque.begin(), m_Opaque.end());
+}
+
+void SpriteQueue::Draw(SpriteRenderer& renderer, const glm::mat4& view, const glm::mat4& projection, bool premultipliedAlpha) const
+{
+	PROFILE_ZONE("SpriteQueue.Draw");
+
+	if (Renderer::GetDepthMode() != Renderer::DepthMode::SplitPasses)
+	{
+		renderer.AlphaCutoff(0.0f);
+		renderer.Draw(m_Sorted, view, projection);
+		return;
+	}
+
+	constexpr float cutoutThreshold{ 0.5f };
+	constexpr float transparentThreshold{ 1.0f / 255.0f };
+
+	Renderer::BeginOpaquePass();
+	renderer.AlphaCutoff(cutoutThreshold);
+	renderer.Draw(m_Opaque, view, projection);
+
+	// Fully transparent texels are still dropped to save the blending work
+	Renderer::BeginTranslucentPass(premultipliedAlpha);
+	renderer.AlphaCutoff(transparentThreshold);
+	renderer.Draw(m_Translucent, view, projection);
+
+	// The next caller finds the blend and depth writes it had before
+	Renderer::EndPasses();
+}
+
+glm::vec4 SpriteQueue::VisibleArea(const glm::mat4& view, const glm::mat4& projection) noexcept
+{
+	// Orthographic: clip = P * (world + viewTranslation), solved for clip = -1 and 1
+	const float left{ (-1.0f - projection[3][0]) / projection[0][0] - view[3][0] };
+	const float right{ (1.0f - projection[3][0]) / projection[0][0] - view[3][0] };
+	const float bottom{ (-1.0f - projection[3][1]) / projection[1][1] - view[3][1] };
+	const float top{ (1.0f - projection[3][1]) / projection[1][1] - view[3][1] };
+
+	return { std::min(left, right), std::min(bottom, top), std::max(left, right), std::max(bottom, top) };
+}
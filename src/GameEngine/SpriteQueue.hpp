@@ -0,0 +1,85 @@
+#pragma once
+#include "Sprite.hpp"
+#include "AlphaClass.hpp"
+#include "RadixSort.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace GameEngine
+{
+	class JobSystem;
+	class SpriteRenderer;
+
+	// Painter's order key: lower layers first, inside a layer the higher Y
+	// (further away in a top-down view) first, then the 24-bit sub-order
+	constexpr std::uint64_t MakeSpriteSortKey(std::uint8_t layer, float y, std::uint32_t subOrder) noexcept
+	{
+		return (static_cast<std::uint64_t>(layer) << 56)
+			| (static_cast<std::uint64_t>(~OrderedFloatBits(y)) << 24)
+			| (subOrder & 0xFFFFFF);
+	}
+
+	// Collects the sprites of a frame, drops the ones outside the visible area
+	// and orders the rest back to front for drawing without depth testing.
+	// For Renderer::DepthMode::SplitPasses the sorted sprites are also split by
+	// their AlphaClass: opaque and cutout ones front to back, translucent ones back to front
+	class SpriteQueue
+	{
+	public:
+		//				[GETTERS]
+
+		// Sprites in drawing order, valid after Sort()
+		std::span<const Sprite> Sorted() const noexcept { return m_Sorted; }
+
+		// Opaque and cutout sprites front to back with depth assigned, valid after Sort()
+		std::span<const Sprite> OpaquePass() const noexcept { return m_Opaque; }
+
+		// Translucent sprites back to front with depth assigned, valid after Sort()
+		std::span<const Sprite> TranslucentPass() const noexcept { return m_Translucent; }
+
+		std::size_t Submitted() const noexcept { return m_Submitted; }
+		std::size_t Visible() const noexcept { return m_Sprites.size(); }
+
+
+		//				[SETTERS]
+
+		// Sprites that do not intersect the area [minX; minY; maxX; maxY] are dropped on Submit()
+		void VisibleArea(const glm::vec4& area) noexcept { m_VisibleArea = area; }
+
+
+		//				[UTILITY]
+
+		void Clear() noexcept;
+		void Submit(const Sprite& sprite, std::uint8_t layer = 0, std::uint32_t subOrder = 0, AlphaClass alpha = AlphaClass::Translucent);
+
+		// Radix sorts the visible sprites by (layer, y, sub-order), in parallel for large counts
+		void Sort(JobSystem* jobs = nullptr);
+
+		// Draws the sorted sprites according to the current Renderer::DepthMode,
+		// the sprite texture has to be bound to GL_TEXTURE0. premultipliedAlpha is the one
+		// of that texture (Texture::PremultipliedAlpha()), it selects the translucent blend.
+		// The split passes restore the blend and depth writes when done (see Renderer::EndPasses())
+		void Draw(SpriteRenderer& renderer, const glm::mat4& view, const glm::mat4& projection, bool premultipliedAlpha = false) const;
+
+		// Visible world area of an orthographic camera without rotation
+		static glm::vec4 VisibleArea(const glm::mat4& view, const glm::mat4& projection) noexcept;
+
+	private:
+		static constexpr float infinity{ std::numeric_limits<float>::infinity() };
+
+		glm::vec4 m_VisibleArea{ -infinity, -infinity, infinity, infinity };
+		std::size_t m_Submitted{};
+
+		std::vector<Sprite> m_Sprites;
+		std::vector<AlphaClass> m_Alpha;
+		std::vector<std::uint64_t> m_Keys;
+		std::vector<std::uint32_t> m_Order;
+		std::vector<Sprite> m_Sorted;
+		std::vector<Sprite> m_Opaque;
+		std::vector<Sprite> m_Translucent;
+		RadixSorter<std::uint64_t> m_Sorter;
+	};
+}
@@ -0,0 +1,54 @@
+#include "SpriteRenderer.hpp"
+#include "QuadSpriteRenderer.hpp"
+#include "PointSpriteRenderer.hpp"
+#include "BufferSpriteRenderer.hpp"
+#include "BatchSpriteRenderer.hpp"
+
+#include <stdexcept>
+
+using namespace GameEngine;
+
+std::unique_ptr<SpriteRenderer> GameEngine::CreateSpriteRenderer(SpriteBackend backend, const std::string& shaderPath)
+{
+	switch (backend)
+	{
+	case SpriteBackend::Quad:			return std::make_unique<QuadSpriteRenderer>(shaderPath);
+	case SpriteBackend::PointSprite:	return std::make_unique<PointSpriteRenderer>(shaderPath);
+	case SpriteBackend::TextureBuffer:			return std::make_unique<BufferSpriteRenderer>(shaderPath, false);
+	case SpriteBackend::TextureBufferInstanced:	return std::make_unique<BufferSpriteRenderer>(shaderPath, true);
+	case SpriteBackend::Batched:				return std::make_unique<FloatSpriteRenderer>(shaderPath);
+	case SpriteBackend::Packed:					return std::make_unique<PackedSpriteRenderer>(shaderPath);
+	case SpriteBackend::PackedFlat:				return std::make_unique<PackedFlatSpriteRenderer>(shaderPath);
+	case SpriteBackend::PackedHalf:				return std::make_unique<PackedHalfSpriteRenderer>(shaderPath);
+	}
+
+	throw std::runtime_error("SpriteRenderer.CreateSpriteRenderer error: unknown backend");
+}
+
+const char* GameEngine::ToString(SpriteBackend backend) noexcept
+{
+	switch (backend)
+	{
+	case SpriteBackend::Quad:			return "quad";
+	case SpriteBackend::PointSprite:	return "point-sprite";
+	case SpriteBackend::TextureBuffer:			return "tbo";
+	case SpriteBackend::TextureBufferInstanced:	return "tbo-instanced";
+	case SpriteBackend::Batched:				return "batched";
+	case SpriteBackend::Packed:					return "packed";
+	case SpriteBackend::PackedFlat:				return "packed-flat";
+	case SpriteBackend::PackedHalf:				return "packed-half";
+	}
+
+	return "unknown";
+}
+
+std::optional<SpriteBackend> GameEngine::ParseSpriteBackend(const std::string& name) noexcept
+{
+	for (SpriteBackend backend : AllSpriteBackends)
+	{
+		if (name == ToString(backend))
+			return backend;
+	}
+
+	return std::nullopt;
+}
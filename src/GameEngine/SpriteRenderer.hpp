@@ -0,0 +1,103 @@
+#pragma once
+#include "Sprite.hpp"
+#include "Palette.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace GameEngine
+{
+	// Available ways of getting the sprites to the GPU
+	enum class SpriteBackend
+	{
+		Quad,			// one glDrawElements call per sprite with the shared indexed quad
+		PointSprite,	// one point per sprite, expanded into a quad by the geometry shader
+		TextureBuffer,			// sprite data pulled from a texture buffer by gl_VertexID, no vertex attributes
+		TextureBufferInstanced,	// same data, one 4-vertex instance per sprite fetched by gl_InstanceID
+		Batched,				// CPU-built quads in the 24-byte float SpriteVertex format
+		Packed,					// CPU-built quads in the 16-byte int16 PackedSpriteVertex format, positions around the camera
+		PackedFlat,				// same without the depth, 12-byte PackedFlatSpriteVertex, painter mode only
+		PackedHalf,				// CPU-built quads in the 16-byte half-float PackedLayeredSpriteVertex format
+	};
+
+	inline constexpr SpriteBackend AllSpriteBackends[] =
+	{
+		SpriteBackend::Quad,
+		SpriteBackend::PointSprite,
+		SpriteBackend::TextureBuffer,
+		SpriteBackend::TextureBufferInstanced,
+		SpriteBackend::Batched,
+		SpriteBackend::Packed,
+		SpriteBackend::PackedFlat,
+		SpriteBackend::PackedHalf,
+	};
+
+	// False for the backends that drop the depth, they only draw right in Renderer::DepthMode::Painter2D
+	constexpr bool KeepsDepth(SpriteBackend backend) noexcept
+	{
+		return backend != SpriteBackend::PackedFlat;
+	}
+
+	// Counters of the work done by a renderer since the last ResetStats()
+	struct SpriteRenderStats
+	{
+		std::size_t drawCalls{};
+		std::size_t sprites{};
+		std::size_t vertices{};
+		std::size_t bytesUploaded{};
+	};
+
+	// Base class of all sprite renderer backends.
+	// Sprites are drawn with the texture that is bound to GL_TEXTURE0, in palette mode
+	// that one holds indices into the palette bound to paletteTextureUnit
+	class SpriteRenderer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		SpriteRenderer() = default;
+		SpriteRenderer(const SpriteRenderer&) = delete;
+		SpriteRenderer& operator=(const SpriteRenderer&) = delete;
+		virtual ~SpriteRenderer() = default;
+
+
+		//				[GETTERS]
+
+		virtual SpriteBackend Backend() const noexcept = 0;
+		const SpriteRenderStats& Stats() const noexcept { return m_Stats; }
+		float AlphaCutoff() const noexcept { return m_AlphaCutoff; }
+		bool PaletteMode() const noexcept { return m_PaletteMode; }
+
+
+		//				[SETTERS]
+
+		// Fragments with a lower alpha are discarded, zero turns the test off
+		void AlphaCutoff(float cutoff) noexcept { m_AlphaCutoff = cutoff; }
+
+		// On for palettized textures (see Texture::Palettized())
+		void PaletteMode(bool enabled) noexcept { m_PaletteMode = enabled; }
+
+
+		//				[UTILITY]
+
+		virtual void Draw(std::span<const Sprite> sprites, const glm::mat4& view, const glm::mat4& projection) = 0;
+		void ResetStats() noexcept { m_Stats = {}; }
+
+	protected:
+		SpriteRenderStats m_Stats{};
+		float m_AlphaCutoff{};
+		bool m_PaletteMode{};
+	};
+
+	// Creates the renderer of a given backend, shaders are loaded from shaderPath
+	// Exceptions: [runtime_error]
+	std::unique_ptr<SpriteRenderer> CreateSpriteRenderer(SpriteBackend backend, const std::string& shaderPath);
+
+	const char* ToString(SpriteBackend backend) noexcept;
+
+	// Inverse of ToString(), empty if the name matches no backend
+	std::optional<SpriteBackend> ParseSpriteBackend(const std::string& name) noexcept;
+}
@@ -0,0 +1,60 @@
+#include "SpriteSheet.hpp"
+
+#include <format>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+// The frames are always classified on the RGBA pixels
+static Image LoadSheetImage(const std::optional<IndexedImage>& indexed, const std::string& imagePath)
+{
+	return indexed ? ExpandIndexedImage(*indexed) : LoadImage(imagePath, 4);
+}
+
+SpriteSheet::SpriteSheet(const std::string& imagePath, int frameWidth, int frameHeight, int maxOutlinePoints, bool keepPalette)
+	: SpriteSheet(keepPalette ? LoadIndexedImage(imagePath) : std::nullopt, imagePath, frameWidth, frameHeight, maxOutlinePoints)
+{ }
+
+SpriteSheet::SpriteSheet(std::optional<IndexedImage> indexed, const std::string& imagePath, int frameWidth, int frameHeight, int maxOutlinePoints)
+	: SpriteSheet(LoadSheetImage(indexed, imagePath), indexed, frameWidth, frameHeight, maxOutlinePoints)
+{ }
+
+SpriteSheet::SpriteSheet(const Image& image, const std::optional<IndexedImage>& indexed, int frameWidth, int frameHeight, int maxOutlinePoints)
+	: m_Texture{ indexed ? Texture{ *indexed } : Texture{ image, GL_NEAREST } }
+{
+	if (frameWidth <= 0 || frameHeight <= 0 || frameWidth > image.width || frameHeight > image.height)
+	{
+		std::string error = std::format("SpriteSheet.SpriteSheet error: frame size {}x{} does not fit the {}x{} image",
+			frameWidth, frameHeight, image.width, image.height);
+		throw std::runtime_error(error);
+	}
+
+	m_Columns = image.width / frameWidth;
+	m_Rows = image.height / frameHeight;
+	m_Frames.reserve(static_cast<std::size_t>(m_Columns) * m_Rows);
+
+	const float width{ static_cast<float>(image.width) };
+	const float height{ static_cast<float>(image.height) };
+
+	for (int row = 0; row < m_Rows; ++row)
+	{
+		// Pixels are stored bottom row first, while frames are counted from the top
+		const int y{ image.height - (row + 1) * frameHeight };
+
+		for (int column = 0; column < m_Columns; ++column)
+		{
+			const int x{ column * frameWidth };
+
+			SpriteFrame frame{};
+			frame.uvRect = { x / width, y / height, (x + frameWidth) / width, (y + frameHeight) / height };
+			frame.alpha = ClassifyAlpha(image.pixels.data(), image.width, 4, x, y, frameWidth, frameHeight);
+			if (frame.alpha != AlphaClass::Opaque)
+				frame.outline = ComputeSpriteOutline(image.pixels.data(), image.width, x, y, frameWidth, frameHeight, maxOutlinePoints);
+
+			m_Frames.push_back(frame);
+		}
+	}
+}
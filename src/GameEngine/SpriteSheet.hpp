@@ -0,0 +1,52 @@
+#pragma once
+#include "Texture.hpp"
+#include "AlphaClass.hpp"
+#include "SpriteOutline.hpp"
+#include <glm/glm.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// Import-time data of a single cell of the sheet
+	struct SpriteFrame
+	{
+		glm::vec4		uvRect{};		// [u0; v0; u1; v1] in the sheet texture
+		AlphaClass		alpha{};
+		SpriteOutline	outline{};		// trimmed polygon around the visible pixels
+	};
+
+	// Atlas of equally sized frames (character animations, tilesets).
+	// Frames are numbered row by row starting from the top-left one
+	class SpriteSheet
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// keepPalette: a PNG with a color map becomes a palettized texture (see Texture::Palettized()).
+		// The indices are recovered from the colors: pixels of a color the palette repeats all get its first entry,
+		// so a palette swap that changes only a later copy of that color misses them
+		// Exceptions: [runtime_error]
+		SpriteSheet(const std::string& imagePath, int frameWidth, int frameHeight, int maxOutlinePoints = SpriteOutline::maxPoints, bool keepPalette = false);
+
+
+		//				[GETTERS]
+
+		Texture& GetTexture() noexcept { return m_Texture; }
+		std::span<const SpriteFrame> Frames() const noexcept { return m_Frames; }
+		const SpriteFrame& Frame(int index) const { return m_Frames.at(static_cast<std::size_t>(index)); }
+		int Columns() const noexcept { return m_Columns; }
+		int Rows() const noexcept { return m_Rows; }
+
+	private:
+		Texture m_Texture;
+		std::vector<SpriteFrame> m_Frames;
+		int m_Columns{};
+		int m_Rows{};
+
+		SpriteSheet(std::optional<IndexedImage> indexed, const std::string& imagePath, int frameWidth, int frameHeight, int maxOutlinePoints);
+		SpriteSheet(const Image& image, const std::optional<IndexedImage>& indexed, int frameWidth, int frameHeight, int maxOutlinePoints);
+	};
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include "VertexLayout.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace GameEngine
+{
+	// Largest distance from the origin, in steps, that an int16 position can store
+	inline constexpr float maxInt16Steps{ 32767.0f };
+
+	// Rounds the value to the nearest step. A clamped value would draw in the wrong place, so
+	// values out of the int16 range, non-finite ones included, are an error
+	// Exceptions: [runtime_error]
+	inline std::int16_t QuantizeInt16(float value, float step)
+	{
+		const float steps{ std::round(value / step) };
+		if (!(steps >= -maxInt16Steps - 1.0f && steps <= maxInt16Steps))
+			throw std::runtime_error("QuantizeInt16 error: the value is out of the int16 range of its origin");
+
+		return static_cast<std::int16_t>(steps);
+	}
+
+	inline std::uint16_t QuantizeUnorm16(float value) noexcept
+	{
+		return glm::packUnorm1x16(value);
+	}
+
+	inline Half QuantizeHalf(float value) noexcept
+	{
+		return { glm::packHalf1x16(value) };
+	}
+
+	// Per draw call parameters of the position quantization
+	struct VertexEncoding
+	{
+		glm::vec2	origin{};				// world position that is stored as zero
+		float		positionStep{ 1.0f };	// world units per integer step
+
+		// Whether every point within reach of the position is stored without clamping,
+		// one step is kept as a margin for the rounding
+		bool Covers(const glm::vec2& position, float reach) const noexcept
+		{
+			const float range{ (maxInt16Steps - 1.0f) * positionStep - reach };
+			return std::abs(position.x - origin.x) <= range && std::abs(position.y - origin.y) <= range;
+		}
+	};
+
+	// Full precision batch vertex, 24 bytes
+	struct SpriteVertex
+	{
+		glm::vec3		position;
+		glm::vec2		texPos;
+		std::uint32_t	tint;		// RGBA8
+
+		using Layout = VertexLayout<
+			VertexAttribute<float, 3>,
+			VertexAttribute<float, 2>,
+			VertexAttribute<std::uint8_t, 4, AttributeMode::Normalized>>;
+
+		static constexpr const char* shader{ "spriteBatch.vert" };
+		static constexpr bool relativePosition{ false };
+
+		static SpriteVertex Encode(const glm::vec3& position, const glm::vec2& texPos, std::uint32_t tint, const VertexEncoding&) noexcept
+		{
+			return { position, texPos, tint };
+		}
+	};
+
+	static_assert(sizeof(SpriteVertex) == SpriteVertex::Layout::stride, "SpriteVertex does not match its layout");
+
+	// 16 bytes per vertex instead of the 24 of SpriteVertex, a third less: the depth keeps
+	// full float precision, so it draws at the same world z as SpriteVertex in every depth mode.
+	// The position is stored in steps relative to an origin that is set per draw call,
+	// so the precision does not depend on how far the sprite is from the world center
+	struct PackedSpriteVertex
+	{
+		std::int16_t	x, y;		// position in steps
+		std::uint16_t	u, v;		// unorm16 texture coordinates
+		std::uint32_t	tint;		// RGBA8
+		float			depth;		// world z
+
+		using Layout = VertexLayout<
+			VertexAttribute<std::int16_t, 2>,
+			VertexAttribute<std::uint16_t, 2, AttributeMode::Normalized>,
+			VertexAttribute<std::uint8_t, 4, AttributeMode::Normalized>,
+			VertexAttribute<float, 1>>;
+
+		static constexpr const char* shader{ "spritePacked.vert" };
+		static constexpr bool relativePosition{ true };
+
+		// Exceptions: [runtime_error] when the position is out of the int16 range around the origin
+		static PackedSpriteVertex Encode(const glm::vec3& position, const glm::vec2& texPos, std::uint32_t tint, const VertexEncoding& encoding)
+		{
+			return {
+				QuantizeInt16(position.x - encoding.origin.x, encoding.positionStep),
+				QuantizeInt16(position.y - encoding.origin.y, encoding.positionStep),
+				QuantizeUnorm16(texPos.x), QuantizeUnorm16(texPos.y),
+				tint,
+				position.z };
+		}
+	};
+
+	static_assert(sizeof(PackedSpriteVertex) == PackedSpriteVertex::Layout::stride, "PackedSpriteVertex does not match its layout");
+
+	// 12 bytes, half of SpriteVertex: PackedSpriteVertex without the depth, which nothing reads
+	// with the depth test off. Only for Renderer::DepthMode::Painter2D, all sprites draw at z = 0
+	struct PackedFlatSpriteVertex
+	{
+		std::int16_t	x, y;		// position in steps
+		std::uint16_t	u, v;		// unorm16 texture coordinates
+		std::uint32_t	tint;		// RGBA8
+
+		using Layout = VertexLayout<
+			VertexAttribute<std::int16_t, 2>,
+			VertexAttribute<std::uint16_t, 2, AttributeMode::Normalized>,
+			VertexAttribute<std::uint8_t, 4, AttributeMode::Normalized>>;
+
+		static constexpr const char* shader{ "spritePackedFlat.vert" };
+		static constexpr bool relativePosition{ true };
+
+		// Exceptions: [runtime_error] when the position is out of the int16 range around the origin
+		static PackedFlatSpriteVertex Encode(const glm::vec3& position, const glm::vec2& texPos, std::uint32_t tint, const VertexEncoding& encoding)
+		{
+			return {
+				QuantizeInt16(position.x - encoding.origin.x, encoding.positionStep),
+				QuantizeInt16(position.y - encoding.origin.y, encoding.positionStep),
+				QuantizeUnorm16(texPos.x), QuantizeUnorm16(texPos.y),
+				tint };
+		}
+	};
+
+	static_assert(sizeof(PackedFlatSpriteVertex) == PackedFlatSpriteVertex::Layout::stride, "PackedFlatSpriteVertex does not match its layout");
+
+	// 16 bytes: PackedSpriteVertex with half-float positions (no origin needed, precision drops
+	// with the distance), the packed layer and sub-image index bytes and a unorm16 depth
+	struct PackedLayeredSpriteVertex
+	{
+		Half			x, y;		// absolute position
+		std::uint16_t	u, v;		// unorm16 texture coordinates
+		std::uint32_t	tint;		// RGBA8
+		std::uint8_t	layer;		// texture array layer or draw layer
+		std::uint8_t	index;		// sub-image index inside the layer
+		std::uint16_t	depth;		// unorm16 depth
+
+		using Layout = VertexLayout<
+			VertexAttribute<Half, 2>,
+			VertexAttribute<std::uint16_t, 2, AttributeMode::Normalized>,
+			VertexAttribute<std::uint8_t, 4, AttributeMode::Normalized>,
+			VertexAttribute<std::uint8_t, 2, AttributeMode::Integer>,
+			VertexAttribute<std::uint16_t, 1, AttributeMode::Normalized>>;
+
+		static constexpr const char* shader{ "spritePackedHalf.vert" };
+		static constexpr bool relativePosition{ false };
+
+		// Depth is expected in [0; 1], layer and index are left for the callers that use them
+		static PackedLayeredSpriteVertex Encode(const glm::vec3& position, const glm::vec2& texPos, std::uint32_t tint, const VertexEncoding&) noexcept
+		{
+			return {
+				QuantizeHalf(position.x), QuantizeHalf(position.y),
+				QuantizeUnorm16(texPos.x), QuantizeUnorm16(texPos.y),
+				tint, 0, 0,
+				QuantizeUnorm16(position.z) };
+		}
+	};
+
+	static_assert(sizeof(PackedLayeredSpriteVertex) == PackedLayeredSpriteVertex::Layout::stride, "PackedLayeredSpriteVertex does not match its layout");
+}
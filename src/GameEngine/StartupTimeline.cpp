@@ -0,0 +1,87 @@
+#include "StartupTimeline.hpp"
+#include "CpuProfiler.hpp"
+
+#include <algorithm>
+#include <format>
+
+using namespace GameEngine;
+
+// Forces the timeline into existence before main()
+static const StartupTimeline& startupTimeline{ StartupTimeline::Instance() };
+
+
+//						[CONSTRUCTORS]
+
+StartupTimeline::StartupTimeline() noexcept
+	: m_Start{ CpuProfiler::Now() }
+{
+}
+
+StartupTimeline& StartupTimeline::Instance()
+{
+	static StartupTimeline timeline;
+	return timeline;
+}
+
+StartupTimeline::Phase::Phase(const char* name, bool worker) noexcept
+	: m_Name{ name }, m_Begin{ CpuProfiler::Now() }, m_Worker{ worker }
+{
+}
+
+StartupTimeline::Phase::~Phase()
+{
+	StartupTimeline::Instance().Record(m_Name, m_Begin, CpuProfiler::Now(), m_Worker);
+}
+
+
+//						[GETTERS]
+
+std::vector<StartupPhase> StartupTimeline::Phases() const
+{
+	std::lock_guard lock{ m_Mutex };
+	return m_Phases;
+}
+
+double StartupTimeline::TimeToFirstFrameMs() const noexcept
+{
+	return m_FirstFrame == 0 ? 0.0 : static_cast<double>(m_FirstFrame - m_Start) / 1.0e6;
+}
+
+
+//						[UTILITY]
+
+void StartupTimeline::Record(std::string name, std::uint64_t begin, std::uint64_t end, bool worker)
+{
+	std::lock_guard lock{ m_Mutex };
+	m_Phases.push_back({ std::move(name), begin, end, worker });
+}
+
+void StartupTimeline::FirstFrame() noexcept
+{
+	if (m_FirstFrame == 0)
+		m_FirstFrame = CpuProfiler::Now();
+}
+
+std::string StartupTimeline::Report() const
+{
+	std::vector<StartupPhase> phases{ Phases() };
+	std::sort(phases.begin(), phases.end(), [](const StartupPhase& a, const StartupPhase& b) { return a.begin < b.begin; });
+
+	auto toMs = [this](std::uint64_t time) { return static_cast<double>(time - m_Start) / 1.0e6; };
+
+	std::string report{ std::format("Startup phases:\n{:<32}{:>10}{:>10}\n", "phase", "at ms", "ms") };
+	double mainThreadMs{};
+	for (const StartupPhase& phase : phases)
+	{
+		const double ms{ static_cast<double>(phase.end - phase.begin) / 1.0e6 };
+		report += std::format("{:<32}{:>10.2f}{:>10.2f}{}\n", phase.name, toMs(phase.begin), ms, phase.worker ? "  (worker)" : "");
+		if (!phase.worker)
+			mainThreadMs += ms;
+	}
+
+	report += std::format("Main thread phases: {:.2f} ms\n", mainThreadMs);
+	if (m_FirstFrame != 0)
+		report += std::format("Time to first frame: {:.2f} ms\n", TimeToFirstFrameMs());
+
+	return report;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// A timed step of the startup, times are CpuProfiler::Now() nanoseconds
+	struct StartupPhase
+	{
+		std::string name;
+		std::uint64_t begin{};
+		std::uint64_t end{};
+		bool worker{};		// ran on a worker thread, overlapping the main thread
+	};
+
+	// Phases from the process start to the first presented frame.
+	// The timeline is created during static initialization, so its zero is before main()
+	class StartupTimeline
+	{
+	public:
+		// Times a phase for its scope
+		class Phase
+		{
+		public:
+			//				[CONSTRUCTORS]
+
+			explicit Phase(const char* name, bool worker = false) noexcept;
+			~Phase();
+
+			Phase(const Phase&) = delete;
+			Phase& operator=(const Phase&) = delete;
+
+		private:
+			const char* m_Name;
+			std::uint64_t m_Begin;
+			bool m_Worker;
+		};
+
+
+		//				[CONSTRUCTORS]
+
+		static StartupTimeline& Instance();
+
+		StartupTimeline(const StartupTimeline&) = delete;
+		StartupTimeline& operator=(const StartupTimeline&) = delete;
+
+
+		//				[GETTERS]
+
+		std::vector<StartupPhase> Phases() const;
+
+		// Zero until FirstFrame()
+		double TimeToFirstFrameMs() const noexcept;
+
+
+		//				[UTILITY]
+
+		// Thread-safe
+		void Record(std::string name, std::uint64_t begin, std::uint64_t end, bool worker = false);
+
+		// Ends the startup, later calls are ignored
+		void FirstFrame() noexcept;
+
+		// Phases in start order with their offset and length, the main thread total and the time to first frame
+		std::string Report() const;
+
+	private:
+		std::uint64_t m_Start{};
+		std::uint64_t m_FirstFrame{};
+		std::vector<StartupPhase> m_Phases;
+		mutable std::mutex m_Mutex;
+
+		StartupTimeline() noexcept;
+	};
+}
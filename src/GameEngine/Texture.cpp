@@ -1,45 +1,274 @@
 #include "Texture.hpp"
+#include "AssetPack.hpp"
+#include "CpuProfiler.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <format>
+#include <utility>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 using namespace GameEngine;
 
+// The GL loader is generated for the core profile only, without the extension enums
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// The internal format follows the channels, GL_RGB used to be passed for RGBA files too and dropped their alpha
 Texture::Texture(const std::string& imagePath, GLenum format)
+	: Texture{ LoadImage(imagePath, format == GL_RGBA ? 4 : 3) }
+{
+}
+
+Texture::Texture(const Image& image, GLint filter)
+{
+	PROFILE_ZONE("Texture upload");
+
+	if (image.channels != 3 && image.channels != 4)
+		throw std::runtime_error("Texture.Texture error: only RGB and RGBA images are supported");
+
+	m_Alpha = ClassifyAlpha(image.pixels.data(), image.width, image.channels, 0, 0, image.width, image.height);
+	if (image.channels == 4)
+		Upload(image.pixels.data(), image.width, image.height, GL_RGBA8, GL_RGBA, filter);
+	else
+		Upload(image.pixels.data(), image.width, image.height, GL_RGB8, GL_RGB, filter);
+}
+
+Texture::Texture(const CookedTexture& cooked, GLint filter, const unsigned char* unpackBufferBase)
+{
+	PROFILE_ZONE("Texture upload");
+
+	m_Alpha = cooked.alpha;
+	m_PremultipliedAlpha = cooked.premultipliedAlpha;
+
+	const int levelCount{ static_cast<int>(cooked.levels.size()) };
+	Create(filter == GL_NEAREST || levelCount == 1 ? filter : GL_LINEAR_MIPMAP_LINEAR, filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+	const bool compressed{ cooked.blockFormat != BlockFormat::None };
+	const bool decodeBlocks{ compressed && !BlockCompressionSupported() };
+	if (decodeBlocks && unpackBufferBase != nullptr)
+		throw std::runtime_error("Texture.Texture error: block compressed levels in an unpack buffer need S3TC support");
+
+	const GLint internalFormat{ cooked.channels == 4 ? GL_RGBA8 : GL_RGB8 };
+	const GLenum format{ static_cast<GLenum>(cooked.channels == 4 && !compressed ? GL_RGBA : GL_RGB) };
+	const GLenum compressedFormat{ static_cast<GLenum>(cooked.blockFormat == BlockFormat::BC1
+		? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) };
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (int level = 0; level < levelCount; ++level)
+	{
+		const int width{ std::max(1, cooked.width >> level) };
+		const int height{ std::max(1, cooked.height >> level) };
+
+		// From an unpack buffer the pointer is an offset into it
+		const unsigned char* pixels = cooked.levels[level].data();
+		if (unpackBufferBase != nullptr)
+			pixels = reinterpret_cast<const unsigned char*>(static_cast<std::uintptr_t>(pixels - unpackBufferBase));
+
+		m_Bytes += compressed && !decodeBlocks ? cooked.levels[level].size() : static_cast<std::size_t>(width) * height * cooked.channels;
+		if (decodeBlocks)
+		{
+			const std::vector<unsigned char> decoded{ DecodeBlocks(cooked.levels[level], width, height, cooked.blockFormat) };
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, decoded.data());
+		}
+		else if (compressed)
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, compressedFormat, width, height, 0,
+				static_cast<GLsizei>(cooked.levels[level].size()), pixels);
+		}
+		else
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+	}
+}
+
+Texture::Texture(const IndexedImage& image)
+{
+	PROFILE_ZONE("Texture upload");
+
+	if (image.indices.size() != static_cast<std::size_t>(image.width) * image.height)
+		throw std::runtime_error("Texture.Texture error: the indexed image size does not match its pixels");
+
+	m_Palette = std::make_shared<Palette>(image.palette);
+
+	// The alpha of every pixel is the alpha of its palette entry
+	bool seen[Palette::maxColors]{};
+	for (unsigned char index : image.indices)
+		seen[index] = true;
+
+	m_Alpha = AlphaClass::Opaque;
+	for (std::size_t i = 0; i * 4 < image.palette.size(); ++i)
+	{
+		const unsigned char alpha{ image.palette[i * 4 + 3] };
+		if (!seen[i] || alpha == 255)
+			continue;
+
+		m_Alpha = alpha == 0 ? AlphaClass::Cutout : AlphaClass::Translucent;
+		if (m_Alpha == AlphaClass::Translucent)
+			break;
+	}
+
+	Create(GL_NEAREST, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, image.width, image.height, 0, GL_RED, GL_UNSIGNED_BYTE, image.indices.data());
+	m_Bytes = image.indices.size() + Palette::maxColors * 4;
+}
+
+Texture::~Texture()
 {
-	int width;
-	int height;
-	int colorChannels;
-	stbi_set_flip_vertically_on_load(true);
+	glDeleteTextures(1, &ID);
+}
 
-	unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &colorChannels, 0);
-	if (!data)
+Texture::Texture(Texture&& other) noexcept
+	: ID{ std::exchange(other.ID, 0u) }
+	, m_Alpha{ other.m_Alpha }
+	, m_PremultipliedAlpha{ other.m_PremultipliedAlpha }
+	, m_Bytes{ std::exchange(other.m_Bytes, 0) }
+	, m_Palette{ std::move(other.m_Palette) }
+{
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept
+{
+	if (this != &other)
 	{
-		stbi_image_free(data);
-		std::string error = std::format("Texture.Texture error: cannot load image file:\n{}", imagePath);
-		throw std::runtime_error(error);
+		glDeleteTextures(1, &ID);
+		ID = std::exchange(other.ID, 0u);
+		m_Alpha = other.m_Alpha;
+		m_PremultipliedAlpha = other.m_PremultipliedAlpha;
+		m_Bytes = std::exchange(other.m_Bytes, 0);
+		m_Palette = std::move(other.m_Palette);
 	}
 
+	return *this;
+}
+
+void Texture::Create(GLint minFilter, GLint magFilter)
+{
 	glGenTextures(1, &ID);
 	glBindTexture(GL_TEXTURE_2D, ID);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+}
+
+void Texture::Upload(const unsigned char* pixels, int width, int height, GLint internalFormat, GLenum format, GLint filter)
+{
+	Create(filter == GL_NEAREST ? GL_NEAREST : GL_LINEAR_MIPMAP_LINEAR, filter);
+
+	// RGB rows of odd widths are not 4-byte aligned
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+	m_Bytes = static_cast<std::size_t>(width) * height * (format == GL_RGBA ? 4 : 3);
+
+	// The mip chain adds a third
+	if (filter != GL_NEAREST)
+	{
+		glGenerateMipmap(GL_TEXTURE_2D);
+		m_Bytes += m_Bytes / 3;
+	}
+}
+
+bool Texture::BlockCompressionSupported()
+{
+	static const bool supported = []
+	{
+		GLint extensionCount{};
+		glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+		for (GLint i = 0; i < extensionCount; ++i)
+		{
+			const auto* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+			if (name != nullptr && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+				return true;
+		}
 
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-	glGenerateMipmap(GL_TEXTURE_2D);
+		return false;
+	}();
 
-	stbi_image_free(data);
+	return supported;
 }
 
 void Texture::Bind(GLenum texUnit)
 {
+	if (m_Palette)
+		m_Palette->Bind();
+
 	glActiveTexture(texUnit);
 	glBindTexture(GL_TEXTURE_2D, ID);
+}
+
+Texture GameEngine::LoadPackTexture(const AssetPack& pack, std::string_view name, JobSystem* jobs, GLint filter)
+{
+	const AssetPackEntry* entry{ pack.Find(name) };
+	if (entry == nullptr)
+		throw std::runtime_error("Texture.LoadPackTexture error: no asset " + std::string{ name });
+
+	if (entry->compression == AssetCompression::None)
+		return Texture{ ParseCookedTexture(pack.Data(name)), filter };
+
+	// The mapping is write-only, the header is decompressed again on the side
+	unsigned char header[sizeof(CookedTextureHeader)]{};
+	const std::span<const unsigned char> headerBytes{ pack.ReadPrefix(*entry, header) };
+
+	// Block compressed levels the driver can't take are decoded on the CPU, which can't read them
+	// back from the buffer. A short header is left to ParseCookedTexture() to report
+	CookedTextureHeader fields{};
+	if (headerBytes.size() == sizeof(fields))
+		std::memcpy(&fields, headerBytes.data(), sizeof(fields));
+
+	if (fields.blockFormat != BlockFormat::None && !Texture::BlockCompressionSupported())
+	{
+		const std::vector<unsigned char> blob{ pack.Read(name, jobs) };
+		return Texture{ ParseCookedTexture(blob), filter };
+	}
+
+	const GLsizeiptr size{ static_cast<GLsizeiptr>(entry->size) };
+	unsigned int unpackBuffer{};
+	glGenBuffers(1, &unpackBuffer);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+	auto* mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	if (mapped == nullptr)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glDeleteBuffers(1, &unpackBuffer);
+		throw std::runtime_error("Texture.LoadPackTexture error: can't map the pixel unpack buffer");
+	}
+
+	bool unmapped{};
+	try
+	{
+		const std::span<unsigned char> blob{ mapped, static_cast<std::size_t>(size) };
+		pack.Read(*entry, blob, jobs);
+
+		// The levels are just offsets into the mapping, nothing is read back from it
+		const CookedTexture cooked{ ParseCookedTexture(headerBytes, blob) };
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		unmapped = true;
+
+		Texture texture{ cooked, filter, mapped };
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glDeleteBuffers(1, &unpackBuffer);
+		return texture;
+	}
+	catch (...)
+	{
+		if (!unmapped)
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glDeleteBuffers(1, &unpackBuffer);
+		throw;
+	}
 }
\ No newline at end of file
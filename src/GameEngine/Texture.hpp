@@ -1,18 +1,79 @@
 #pragma once
 #include <glad/glad.h>
 #include <glfw3.h>
+#include "AlphaClass.hpp"
+#include "Image.hpp"
+#include "CookedTexture.hpp"
+#include "IndexedImage.hpp"
+#include "Palette.hpp"
+#include <memory>
 #include <string>
+#include <string_view>
 
 namespace GameEngine
 {
+	class AssetPack;
+	class JobSystem;
+
 	class Texture
 	{
 	public:
+		// GL_RGB or GL_RGBA, the file is decoded to that many channels
+		// Exceptions: [runtime_error]
 		Texture(const std::string& imagePath, GLenum format = GL_RGB);
 
+		// Uploads an already decoded RGB or RGBA image, GL_NEAREST filtering skips the mipmaps
+		// Exceptions: [runtime_error]
+		explicit Texture(const Image& image, GLint filter = GL_LINEAR);
+
+		// Uploads a cooked texture as it is: no decode, no alpha scan, the mip levels come from the blob.
+		// With a pixel unpack buffer bound the levels lie in it, unpackBufferBase is where it was mapped.
+		// Block compressed levels are decoded on the CPU when the GPU has no S3TC (not from a buffer)
+		// Exceptions: [runtime_error]
+		explicit Texture(const CookedTexture& cooked, GLint filter = GL_LINEAR, const unsigned char* unpackBufferBase = nullptr);
+
+		// Palettized: the indices go to an R8 texture and the colors to a Palette, both sampled
+		// with GL_NEAREST and without mipmaps. Sprites need SpriteRenderer::PaletteMode()
+		explicit Texture(const IndexedImage& image);
+		~Texture();
+
+		// Owns the GL texture, so it moves but does not copy
+		Texture(Texture&& other) noexcept;
+		Texture& operator=(Texture&& other) noexcept;
+		Texture(const Texture&) = delete;
+		Texture& operator=(const Texture&) = delete;
+
+		// A palettized texture binds its palette to paletteTextureUnit as well
 		void Bind(GLenum texUnit = GL_TEXTURE0);
 
+		// Classification of the whole image made on load
+		AlphaClass Alpha() const noexcept { return m_Alpha; }
+
+		// Blend with GL_ONE instead of GL_SRC_ALPHA (see Renderer::BeginTranslucentPass)
+		bool PremultipliedAlpha() const noexcept { return m_PremultipliedAlpha; }
+
+		// Estimated video memory of the levels as uploaded, the palette included
+		std::size_t Bytes() const noexcept { return m_Bytes; }
+
+		bool Palettized() const noexcept { return m_Palette != nullptr; }
+		const std::shared_ptr<Palette>& GetPalette() const noexcept { return m_Palette; }
+
+		// Whether the context samples BC1/BC3 (GL_EXT_texture_compression_s3tc), asked once
+		static bool BlockCompressionSupported();
+
 	private:
-		unsigned int ID;
+		unsigned int ID{};
+		AlphaClass m_Alpha{ AlphaClass::Opaque };
+		bool m_PremultipliedAlpha{};
+		std::size_t m_Bytes{};
+		std::shared_ptr<Palette> m_Palette;		// one palette can serve several textures
+
+		void Create(GLint minFilter, GLint magFilter);
+		void Upload(const unsigned char* pixels, int width, int height, GLint internalFormat, GLenum format, GLint filter);
 	};
+
+	// Uploads a cooked texture of the pack. A compressed one is decompressed by the jobs
+	// straight into a mapped pixel unpack buffer, the driver copies it from there
+	// Exceptions: [runtime_error]
+	Texture LoadPackTexture(const AssetPack& pack, std::string_view name, JobSystem* jobs = nullptr, GLint filter = GL_LINEAR);
 }
@@ -0,0 +1,294 @@
+#include "TextureManager.hpp"
+#include "AssetPack.hpp"
+#include "CookedTexture.hpp"
+#include "CpuProfiler.hpp"
+#include "JobSystem.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+// Grey images are widened to RGB(A), the texture formats start at 3 channels
+static Image DecodeTextureImage(std::span<const unsigned char> bytes, const std::string& name)
+{
+	Image image{ DecodeImage(bytes, 0, name) };
+	if (image.channels < 3)
+		image = DecodeImage(bytes, image.channels == 2 ? 4 : 3, name);
+
+	return image;
+}
+
+// Runs on a loader thread, no GL calls here
+static TextureLoadResult LoadTextureData(const std::string& key, const AssetPack* pack)
+{
+	PROFILE_ZONE("Texture load");
+	TextureLoadResult result{};
+
+	if (pack != nullptr && pack->Contains(CookedTextureName(key)))
+	{
+		result.cooked = pack->Read(CookedTextureName(key));
+		result.contentHash = HashAssetData(result.cooked);
+	}
+	else if (pack != nullptr && pack->Contains(key))
+	{
+		const std::vector<unsigned char> bytes{ pack->Read(key) };
+		result.contentHash = HashAssetData(bytes);
+		result.image = DecodeTextureImage(bytes, key);
+	}
+	else
+	{
+		const MappedFile file{ key };
+		result.contentHash = HashAssetData(file.Bytes());
+		result.image = DecodeTextureImage(file.Bytes(), key);
+	}
+
+	return result;
+}
+
+
+//						[CONSTRUCTORS]
+
+TextureManager::TextureManager(JobSystem& loaders, const TextureManagerSettings& settings, const AssetPack* pack)
+	: m_Loaders{ loaders }
+	, m_Settings{ settings }
+	, m_Pack{ pack }
+	, m_Placeholder{ Image{ 1, 1, 4, { 0, 0, 0, 0 } }, GL_NEAREST }
+{
+}
+
+// The texture deleters update the stats, so the textures go before the rest of the manager.
+// Loads still in flight finish on the loaders and are dropped
+TextureManager::~TextureManager()
+{
+	for (auto& [key, entry] : m_Entries)
+	{
+		entry->texture.reset();
+		entry->manager = nullptr;
+	}
+}
+
+
+//						[GETTERS]
+
+Texture& TextureHandle::Get() const
+{
+	TextureCacheEntry& entry = *m_Entry;
+	TextureManager& manager = *entry.manager;
+
+	entry.lastUsedFrame = manager.m_Frame;
+	if (entry.texture)
+		return *entry.texture;
+
+	if (!entry.load.valid() && !entry.failed)
+	{
+		++manager.m_Stats.misses;
+		manager.StartLoad(m_Entry);
+	}
+
+	return manager.m_Placeholder;
+}
+
+
+//						[UTILITY]
+
+TextureHandle TextureManager::Load(const std::string& path, GLint filter)
+{
+	// Pack names are already normalized, files are keyed by their canonical path
+	std::string key{ path };
+	if (m_Pack == nullptr || !(m_Pack->Contains(CookedTextureName(path)) || m_Pack->Contains(path)))
+	{
+		std::error_code error;
+		const std::filesystem::path canonical{ std::filesystem::weakly_canonical(path, error) };
+		if (!error)
+			key = canonical.generic_string();
+	}
+
+	TextureHandle handle{};
+	auto found = m_Entries.find(key);
+	if (found != m_Entries.end())
+	{
+		handle.m_Entry = found->second;
+		handle.m_Entry->lastUsedFrame = m_Frame;
+		handle.m_Entry->failed = false;
+
+		if (handle.m_Entry->texture || handle.m_Entry->load.valid())
+		{
+			++m_Stats.hits;
+			return handle;
+		}
+	}
+	else
+	{
+		handle.m_Entry = std::make_shared<TextureCacheEntry>();
+		handle.m_Entry->manager = this;
+		handle.m_Entry->key = key;
+		handle.m_Entry->filter = filter;
+		handle.m_Entry->lastUsedFrame = m_Frame;
+		m_Entries.emplace(key, handle.m_Entry);
+	}
+
+	++m_Stats.misses;
+	StartLoad(handle.m_Entry);
+	return handle;
+}
+
+void TextureManager::Update()
+{
+	PROFILE_ZONE("TextureManager.Update");
+
+	++m_Frame;
+	const std::string errors{ FinishLoads(false) };
+	Evict();
+
+	if (!errors.empty())
+		throw std::runtime_error("TextureManager.Update error: " + errors);
+}
+
+void TextureManager::Flush()
+{
+	const std::string errors{ FinishLoads(true) };
+	if (!errors.empty())
+		throw std::runtime_error("TextureManager.Flush error: " + errors);
+}
+
+std::string TextureManager::Report() const
+{
+	return std::format("Textures: {} resident, {:.1f} MiB of {:.1f} MiB budget, {} loading\n"
+		"Cache: {} hits, {} misses, {} content hits, {} evictions\n",
+		m_Stats.residentTextures, static_cast<double>(m_Stats.residentBytes) / (1024.0 * 1024.0),
+		static_cast<double>(m_Settings.vramBudget) / (1024.0 * 1024.0), m_Stats.loadsInFlight,
+		m_Stats.hits, m_Stats.misses, m_Stats.contentHits, m_Stats.evictions);
+}
+
+
+//						[PRIVATE]
+
+void TextureManager::StartLoad(const std::shared_ptr<TextureCacheEntry>& entry)
+{
+	entry->load = m_Loaders.Submit([key = entry->key, pack = m_Pack]()
+	{
+		return LoadTextureData(key, pack);
+	});
+
+	m_Loading.push_back(entry);
+	m_Stats.loadsInFlight = m_Loading.size();
+}
+
+void TextureManager::FinishLoad(TextureCacheEntry& entry)
+{
+	TextureLoadResult result{ entry.load.get() };
+
+	// Identical contents under another path share the GL texture, as long as the filter matches
+	const std::uint64_t contentKey{ result.contentHash ^ static_cast<std::uint64_t>(entry.filter) };
+	std::weak_ptr<Texture>& shared = m_ByContent[contentKey];
+	entry.texture = shared.lock();
+	if (entry.texture)
+	{
+		++m_Stats.contentHits;
+		return;
+	}
+
+	std::unique_ptr<Texture> texture = result.image
+		? std::make_unique<Texture>(*result.image, entry.filter)
+		: std::make_unique<Texture>(ParseCookedTexture(result.cooked), entry.filter);
+
+	m_Stats.residentBytes += texture->Bytes();
+	++m_Stats.residentTextures;
+
+	entry.texture = std::shared_ptr<Texture>(texture.release(), [this, contentKey](Texture* texture)
+	{
+		m_Stats.residentBytes -= texture->Bytes();
+		--m_Stats.residentTextures;
+		m_ByContent.erase(contentKey);
+		delete texture;
+	});
+	shared = entry.texture;
+}
+
+std::string TextureManager::FinishLoads(bool wait)
+{
+	std::string errors;
+	for (std::size_t i = 0; i < m_Loading.size();)
+	{
+		TextureCacheEntry& entry = *m_Loading[i];
+		if (!wait && entry.load.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready)
+		{
+			++i;
+			continue;
+		}
+
+		try
+		{
+			FinishLoad(entry);
+		}
+		catch (const std::exception& except)
+		{
+			entry.failed = true;
+			errors += std::format("{}{}: {}", errors.empty() ? "" : "\n", entry.key, except.what());
+		}
+
+		m_Loading[i] = std::move(m_Loading.back());
+		m_Loading.pop_back();
+	}
+
+	m_Stats.loadsInFlight = m_Loading.size();
+	return errors;
+}
+
+// Least recently used first, never a texture one of its paths used in the last evictAfterFrames frames.
+// Paths sharing a texture by content are evicted together, dropping one of them alone frees nothing.
+// Entries no handle refers to are forgotten once evicted
+void TextureManager::Evict()
+{
+	if (m_Stats.residentBytes <= m_Settings.vramBudget)
+		return;
+
+	struct Resident
+	{
+		std::uint64_t lastUsedFrame{};
+		std::vector<TextureCacheEntry*> entries;
+	};
+
+	std::unordered_map<const Texture*, Resident> residents;
+	for (auto& [key, entry] : m_Entries)
+	{
+		if (!entry->texture)
+			continue;
+
+		Resident& resident = residents[entry->texture.get()];
+		resident.lastUsedFrame = std::max(resident.lastUsedFrame, entry->lastUsedFrame);
+		resident.entries.push_back(entry.get());
+	}
+
+	std::vector<Resident*> candidates;
+	for (auto& [texture, resident] : residents)
+	{
+		if (m_Frame - resident.lastUsedFrame >= m_Settings.evictAfterFrames)
+			candidates.push_back(&resident);
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [](const Resident* a, const Resident* b)
+	{
+		return a->lastUsedFrame < b->lastUsedFrame;
+	});
+
+	for (Resident* resident : candidates)
+	{
+		if (m_Stats.residentBytes <= m_Settings.vramBudget)
+			break;
+
+		for (TextureCacheEntry* entry : resident->entries)
+			entry->texture.reset();
+		++m_Stats.evictions;
+	}
+
+	std::erase_if(m_Entries, [](const auto& item)
+	{
+		return !item.second->texture && !item.second->load.valid() && item.second.use_count() == 1;
+	});
+}
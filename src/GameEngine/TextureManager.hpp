@@ -0,0 +1,146 @@
+#pragma once
+#include "Texture.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GameEngine
+{
+	class AssetPack;
+	class JobSystem;
+	class TextureManager;
+
+	struct TextureManagerSettings
+	{
+		// Over that many bytes of resident textures the least recently used ones are evicted
+		std::size_t vramBudget{ 256 * 1024 * 1024 };
+
+		// Only textures unused for that many frames can be evicted, the visible ones stay
+		std::uint64_t evictAfterFrames{ 120 };
+	};
+
+	struct TextureCacheStats
+	{
+		std::size_t residentBytes{};
+		std::size_t residentTextures{};		// distinct GL textures, paths with the same contents share one
+		std::size_t hits{};					// Load() of a path that was already there
+		std::size_t misses{};				// loads from the disk or the pack, evicted textures count again
+		std::size_t contentHits{};			// loaded under another path but identical to a resident texture
+		std::size_t evictions{};
+		std::size_t loadsInFlight{};
+	};
+
+	// Decoded on a loader thread, uploaded on the GL one
+	struct TextureLoadResult
+	{
+		std::optional<Image> image;
+		std::vector<unsigned char> cooked;		// a cooked texture blob instead, see CookedTexture
+		std::uint64_t contentHash{};
+	};
+
+	// State of one path, shared by the manager and its handles
+	struct TextureCacheEntry
+	{
+		TextureManager* manager{};
+		std::string key;						// canonical path, or the pack name
+		GLint filter{ GL_LINEAR };
+		std::shared_ptr<Texture> texture;		// empty while not resident
+		std::future<TextureLoadResult> load;	// valid while loading
+		std::uint64_t lastUsedFrame{};
+		bool failed{};							// not retried until the next Load()
+	};
+
+	// Reference to a managed texture. Copies share the entry, which stays in the cache
+	// while any handle to it lives or until the texture is evicted. Must not outlive the manager
+	class TextureHandle
+	{
+	public:
+		//				[GETTERS]
+
+		// The texture to bind, marked as used in the current frame. While it is loading, or
+		// loading again after an eviction, this is a transparent 1x1 placeholder.
+		// Valid until the next TextureManager::Update(), ask again every frame
+		Texture& Get() const;
+
+		bool Resident() const noexcept { return m_Entry && m_Entry->texture != nullptr; }
+		const std::string& Key() const noexcept { return m_Entry->key; }
+
+		explicit operator bool() const noexcept { return m_Entry != nullptr; }
+
+	private:
+		friend class TextureManager;
+
+		std::shared_ptr<TextureCacheEntry> m_Entry;
+	};
+
+	// Loads textures once however many times they are asked for: paths are deduplicated by their
+	// canonical form, contents by a hash of the file bytes. Files are read and decoded on the loader
+	// threads, the uploads happen in Update() on the GL thread. Textures unused for a while are evicted
+	// in LRU order when the resident ones go over the budget, and quietly reloaded when used again
+	class TextureManager
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// With a pack the textures come from it, cooked ones preferred (see CookedTextureName())
+		TextureManager(JobSystem& loaders, const TextureManagerSettings& settings = {}, const AssetPack* pack = nullptr);
+		~TextureManager();
+
+		TextureManager(const TextureManager&) = delete;
+		TextureManager& operator=(const TextureManager&) = delete;
+
+
+		//				[GETTERS]
+
+		const TextureCacheStats& Stats() const noexcept { return m_Stats; }
+		const TextureManagerSettings& Settings() const noexcept { return m_Settings; }
+		std::uint64_t Frame() const noexcept { return m_Frame; }
+
+
+		//				[SETTERS]
+
+		void Settings(const TextureManagerSettings& settings) noexcept { m_Settings = settings; }
+
+
+		//				[UTILITY]
+
+		// Starts loading on a miss. The filter of the first Load() of a path is kept
+		TextureHandle Load(const std::string& path, GLint filter = GL_LINEAR);
+
+		// Once per frame on the GL thread: uploads the finished loads, then evicts over the budget
+		// Exceptions: [runtime_error] when a texture failed to load, the other ones are still uploaded
+		void Update();
+
+		// Blocks until every load in flight is uploaded (startup, loading screens)
+		// Exceptions: [runtime_error]
+		void Flush();
+
+		// Multiline summary of Stats()
+		std::string Report() const;
+
+	private:
+		friend class TextureHandle;
+
+		JobSystem& m_Loaders;
+		TextureManagerSettings m_Settings;
+		const AssetPack* m_Pack{};
+		std::unordered_map<std::string, std::shared_ptr<TextureCacheEntry>> m_Entries;
+		std::unordered_map<std::uint64_t, std::weak_ptr<Texture>> m_ByContent;
+		std::vector<std::shared_ptr<TextureCacheEntry>> m_Loading;
+		Texture m_Placeholder;
+		TextureCacheStats m_Stats{};
+		std::uint64_t m_Frame{};
+
+		void StartLoad(const std::shared_ptr<TextureCacheEntry>& entry);
+		void FinishLoad(TextureCacheEntry& entry);
+
+		// Error messages of the failed loads, empty when all went well
+		std::string FinishLoads(bool wait);
+		void Evict();
+	};
+}
@@ -0,0 +1,110 @@
+#include "TileArray.hpp"
+#include "CpuProfiler.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+static std::vector<Image> LoadTilesets(std::span<const std::string> paths)
+{
+	std::vector<Image> images;
+	images.reserve(paths.size());
+	for (const std::string& path : paths)
+		images.push_back(LoadImage(path, 4));
+
+	return images;
+}
+
+TileArray::TileArray(std::span<const std::string> tilesetPaths, int tileWidth, int tileHeight)
+	: TileArray(LoadTilesets(tilesetPaths), tileWidth, tileHeight)
+{ }
+
+TileArray::TileArray(std::span<const Image> tilesets, int tileWidth, int tileHeight)
+	: m_TileWidth{ tileWidth }
+	, m_TileHeight{ tileHeight }
+{
+	PROFILE_ZONE("Texture upload");
+
+	if (tileWidth <= 0 || tileHeight <= 0)
+		throw std::runtime_error("TileArray.TileArray error: the tile size is non-positive");
+
+	const std::size_t rowBytes{ static_cast<std::size_t>(tileWidth) * 4 };
+	const std::size_t layerBytes{ rowBytes * tileHeight };
+	std::vector<unsigned char> layers;
+
+	for (const Image& image : tilesets)
+	{
+		if (image.channels != 4 || tileWidth > image.width || tileHeight > image.height)
+		{
+			std::string error = std::format("TileArray.TileArray error: {}x{} tiles do not fit a {}x{} image of {} channels",
+				tileWidth, tileHeight, image.width, image.height, image.channels);
+			throw std::runtime_error(error);
+		}
+
+		m_FirstLayers.push_back(LayerCount());
+
+		const int columns{ image.width / tileWidth };
+		const int rows{ image.height / tileHeight };
+		for (int row = 0; row < rows; ++row)
+		{
+			// Pixels are stored bottom row first, while tiles are counted from the top
+			const int y{ image.height - (row + 1) * tileHeight };
+
+			for (int column = 0; column < columns; ++column)
+			{
+				const int x{ column * tileWidth };
+
+				const std::size_t layerOffset{ layers.size() };
+				layers.resize(layerOffset + layerBytes);
+				for (int line = 0; line < tileHeight; ++line)
+				{
+					const unsigned char* source = &image.pixels[(static_cast<std::size_t>(y + line) * image.width + x) * 4];
+					std::copy_n(source, rowBytes, &layers[layerOffset + line * rowBytes]);
+				}
+
+				m_Alpha.push_back(ClassifyAlpha(image.pixels.data(), image.width, 4, x, y, tileWidth, tileHeight));
+			}
+		}
+	}
+
+	GLint maxTextureLayers{};
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxTextureLayers);
+	if (LayerCount() == 0 || LayerCount() > std::min(maxLayers, static_cast<int>(maxTextureLayers)))
+	{
+		std::string error = std::format("TileArray.TileArray error: {} tiles, the texture array takes 1 to {}",
+			LayerCount(), std::min(maxLayers, static_cast<int>(maxTextureLayers)));
+		throw std::runtime_error(error);
+	}
+
+	glGenTextures(1, &m_Texture);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+
+	// Pixel art: exact texels, and the layer edge is clamped instead of wrapping into the next tile
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, tileWidth, tileHeight, LayerCount(), 0, GL_RGBA, GL_UNSIGNED_BYTE, layers.data());
+}
+
+TileArray::~TileArray()
+{
+	glDeleteTextures(1, &m_Texture);
+}
+
+
+//						[UTILITY]
+
+void TileArray::Bind(GLenum texUnit) const
+{
+	glActiveTexture(texUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_Texture);
+}
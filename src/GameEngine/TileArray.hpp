@@ -0,0 +1,63 @@
+#pragma once
+#include "AlphaClass.hpp"
+#include "Image.hpp"
+#include <glad/glad.h>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	// Tiles of one cell size (8x8, 16x16) sliced out of one or more tilesets, each tile in its own
+	// layer of a GL_TEXTURE_2D_ARRAY. Sampling clamps to the layer, so no neighbour bleeds in, and
+	// all the tilesets need a single binding. Tiles are numbered like SpriteSheet frames (row by row
+	// from the top-left), tileset after tileset: layer = FirstLayer(tileset) + frame
+	class TileArray
+	{
+	public:
+		// Layer indices are stored in 16 bits per tile (see Tile)
+		static constexpr int maxLayers{ 65536 };
+
+		//				[CONSTRUCTORS]
+
+		// Partial tiles at the right and bottom edges are dropped
+		// Exceptions: [runtime_error]
+		TileArray(std::span<const std::string> tilesetPaths, int tileWidth, int tileHeight);
+
+		// RGBA images with rows from bottom to top, as LoadImage() gives them
+		// Exceptions: [runtime_error]
+		TileArray(std::span<const Image> tilesets, int tileWidth, int tileHeight);
+		~TileArray();
+
+		TileArray(const TileArray&) = delete;
+		TileArray& operator=(const TileArray&) = delete;
+
+
+		//				[GETTERS]
+
+		int TileWidth() const noexcept { return m_TileWidth; }
+		int TileHeight() const noexcept { return m_TileHeight; }
+		int LayerCount() const noexcept { return static_cast<int>(m_Alpha.size()); }
+		int TilesetCount() const noexcept { return static_cast<int>(m_FirstLayers.size()); }
+
+		int FirstLayer(int tileset) const { return m_FirstLayers.at(static_cast<std::size_t>(tileset)); }
+		int Layer(int tileset, int frame) const { return FirstLayer(tileset) + frame; }
+
+		// Classification of the single tile
+		AlphaClass Alpha(int layer) const { return m_Alpha.at(static_cast<std::size_t>(layer)); }
+
+		unsigned int GetID() const noexcept { return m_Texture; }
+
+
+		//				[UTILITY]
+
+		void Bind(GLenum texUnit = GL_TEXTURE0) const;
+
+	private:
+		unsigned int m_Texture{};
+		int m_TileWidth{};
+		int m_TileHeight{};
+		std::vector<int> m_FirstLayers;
+		std::vector<AlphaClass> m_Alpha;
+	};
+}
@@ -0,0 +1,67 @@
+#include "TileRenderer.hpp"
+#include "CpuProfiler.hpp"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+
+using namespace GameEngine;
+
+
+//						[CONSTRUCTORS]
+
+TileRenderer::TileRenderer(const std::string& shaderPath)
+	: m_Shader{ shaderPath + "tile.vert", shaderPath + "tile.frag" }
+{
+	glGenVertexArrays(1, &m_VAO);
+	glBindVertexArray(m_VAO);
+
+	glGenBuffers(1, &m_VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	Tile::Layout::Apply(0, 1);
+	glBindVertexArray(0);
+
+	m_Shader.Use();
+	m_Shader.SetInt("tileTexture", 0);
+}
+
+TileRenderer::~TileRenderer()
+{
+	glDeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteProgram(m_Shader.GetID());
+}
+
+
+//						[UTILITY]
+
+void TileRenderer::Draw(std::span<const Tile> tiles, const TileGrid& grid, const glm::mat4& view, const glm::mat4& projection)
+{
+	if (tiles.empty())
+		return;
+
+	PROFILE_ZONE("TileRenderer.Draw");
+
+	const std::size_t bytes{ tiles.size_bytes() };
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	m_Capacity = std::max(m_Capacity, tiles.size());
+	glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(Tile), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, tiles.data());
+
+	m_Shader.Use();
+	m_Shader.SetMat4f("view", glm::value_ptr(view));
+	m_Shader.SetMat4f("projection", glm::value_ptr(projection));
+	m_Shader.SetFloat("alphaCutoff", m_AlphaCutoff);
+	m_Shader.SetFloat4("grid", grid.origin.x, grid.origin.y, grid.cellSize.x, grid.cellSize.y);
+	m_Shader.SetFloat("depth", grid.depth);
+
+	glBindVertexArray(m_VAO);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(tiles.size()));
+	glBindVertexArray(0);
+
+	m_Stats.drawCalls += 1;
+	m_Stats.sprites += tiles.size();
+	m_Stats.vertices += tiles.size() * 4;
+	m_Stats.bytesUploaded += bytes;
+}
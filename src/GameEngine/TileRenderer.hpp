@@ -0,0 +1,82 @@
+#pragma once
+#include "SpriteRenderer.hpp"
+#include "Shader.hpp"
+#include "VertexLayout.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace GameEngine
+{
+	enum TileFlags : std::uint16_t
+	{
+		TileFlipX = 1,
+		TileFlipY = 2,
+	};
+
+	// One cell of a tile map, 8 bytes: the TileArray layer index takes the place of
+	// the position, size and UV rectangle of a Sprite
+	struct Tile
+	{
+		std::int16_t	x, y;		// grid cell, (0; 0) is the one at the grid origin
+		std::uint16_t	layer;		// TileArray layer
+		std::uint16_t	flags;		// TileFlags
+
+		using Layout = VertexLayout<
+			VertexAttribute<std::int16_t, 2, AttributeMode::Integer>,
+			VertexAttribute<std::uint16_t, 2, AttributeMode::Integer>>;
+	};
+
+	static_assert(sizeof(Tile) == Tile::Layout::stride, "Tile does not match its layout");
+
+	// Placement of the grid in the world
+	struct TileGrid
+	{
+		glm::vec2	origin{};				// bottom-left corner of cell (0; 0)
+		glm::vec2	cellSize{ 1.0f };		// in world units
+		float		depth{};
+	};
+
+	// Draws tiles with the TileArray that is bound to GL_TEXTURE0. Every tile is a 4-vertex
+	// instance expanded in the vertex shader and sampled by its layer index, so a whole map
+	// is one draw call no matter how many tilesets it mixes
+	class TileRenderer
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		explicit TileRenderer(const std::string& shaderPath);
+		~TileRenderer();
+
+		TileRenderer(const TileRenderer&) = delete;
+		TileRenderer& operator=(const TileRenderer&) = delete;
+
+
+		//				[GETTERS]
+
+		const SpriteRenderStats& Stats() const noexcept { return m_Stats; }
+		float AlphaCutoff() const noexcept { return m_AlphaCutoff; }
+
+
+		//				[SETTERS]
+
+		// Fragments with a lower alpha are discarded, zero turns the test off
+		void AlphaCutoff(float cutoff) noexcept { m_AlphaCutoff = cutoff; }
+
+
+		//				[UTILITY]
+
+		void Draw(std::span<const Tile> tiles, const TileGrid& grid, const glm::mat4& view, const glm::mat4& projection);
+		void ResetStats() noexcept { m_Stats = {}; }
+
+	private:
+		Shader m_Shader;
+		unsigned int m_VAO{};
+		unsigned int m_VBO{};
+		std::size_t m_Capacity{};		// in tiles
+		SpriteRenderStats m_Stats{};
+		float m_AlphaCutoff{};
+	};
+}
@@ -0,0 +1,101 @@
+#include "TraceWriter.hpp"
+
+#include <format>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+//						[CONSTRUCTORS]
+
+TraceWriter::TraceWriter(const std::string& path, std::uint64_t origin)
+	: m_File{ path }, m_Path{ path }, m_Origin{ origin }
+{
+	if (!m_File)
+		throw std::runtime_error("TraceWriter.TraceWriter error: can't open " + path);
+
+	m_File << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+}
+
+
+//						[UTILITY]
+
+void TraceWriter::ThreadName(std::uint32_t threadId, const std::string& name)
+{
+	Separator();
+	m_File << std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})", threadId, Escape(name));
+}
+
+void TraceWriter::Complete(const std::string& name, std::uint32_t threadId, std::uint64_t begin, std::uint64_t end, const std::string& argsJson)
+{
+	Separator();
+	m_File << std::format(R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f})",
+		Escape(name), threadId, Micros(begin), Micros(end) - Micros(begin));
+
+	if (!argsJson.empty())
+		m_File << ",\"args\":" << argsJson;
+	m_File << '}';
+}
+
+void TraceWriter::Instant(const std::string& name, std::uint32_t threadId, std::uint64_t time, bool global, const std::string& detail)
+{
+	Separator();
+	m_File << std::format(R"({{"name":"{}","ph":"i","s":"{}","pid":1,"tid":{},"ts":{:.3f})",
+		Escape(name), global ? "g" : "t", threadId, Micros(time));
+
+	if (!detail.empty())
+		m_File << std::format(R"(,"args":{{"detail":"{}"}})", Escape(detail));
+	m_File << '}';
+}
+
+void TraceWriter::Counter(const std::string& name, std::uint64_t time, double value)
+{
+	Separator();
+	m_File << std::format(R"({{"name":"{}","ph":"C","pid":1,"ts":{:.3f},"args":{{"value":{:.3f}}}}})", Escape(name), Micros(time), value);
+}
+
+void TraceWriter::Finish(const std::string& extraJson)
+{
+	if (m_Finished)
+		return;
+
+	m_File << "\n]";
+	if (!extraJson.empty())
+		m_File << ",\n" << extraJson;
+	m_File << "}\n";
+	m_File.flush();
+	m_Finished = true;
+
+	if (!m_File)
+		throw std::runtime_error("TraceWriter.Finish error: failed to write " + m_Path);
+}
+
+std::string TraceWriter::Escape(const std::string& text)
+{
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+
+		if (static_cast<unsigned char>(c) < 0x20)
+			escaped += ' ';
+		else
+			escaped += c;
+	}
+
+	return escaped;
+}
+
+double TraceWriter::Micros(std::uint64_t time) const noexcept
+{
+	// Events from before the origin (a zone that began earlier) get negative times
+	return (static_cast<double>(time) - static_cast<double>(m_Origin)) / 1000.0;
+}
+
+void TraceWriter::Separator()
+{
+	if (!m_First)
+		m_File << ",\n";
+	m_First = false;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace GameEngine
+{
+	// Streams a Chrome trace_event JSON file (chrome://tracing, Perfetto).
+	// Times are steady_clock nanoseconds, written in microseconds relative to origin
+	class TraceWriter
+	{
+	public:
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		TraceWriter(const std::string& path, std::uint64_t origin);
+
+
+		//				[UTILITY]
+
+		void ThreadName(std::uint32_t threadId, const std::string& name);
+		// argsJson is an optional JSON object shown with the event
+		void Complete(const std::string& name, std::uint32_t threadId, std::uint64_t begin, std::uint64_t end, const std::string& argsJson = {});
+
+		// Instant event, global ones are drawn across every thread track
+		void Instant(const std::string& name, std::uint32_t threadId, std::uint64_t time, bool global = false, const std::string& detail = {});
+
+		// Counter track sample
+		void Counter(const std::string& name, std::uint64_t time, double value);
+
+		// Closes the event array, extraJson is added as "name":value members of the root object
+		// Exceptions: [runtime_error]
+		void Finish(const std::string& extraJson = {});
+
+		static std::string Escape(const std::string& text);
+
+	private:
+		std::ofstream m_File;
+		std::string m_Path;
+		std::uint64_t m_Origin{};
+		bool m_First{ true };
+		bool m_Finished{};
+
+		double Micros(std::uint64_t time) const noexcept;
+		void Separator();
+	};
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace GameEngine
+{
+	// Storage type of a half-precision float component
+	struct Half
+	{
+		std::uint16_t bits;
+	};
+
+	// How the shader sees the stored components
+	enum class AttributeMode
+	{
+		Float,			// converted to float as is (int16 100 -> 100.0)
+		Normalized,		// mapped to [0; 1] or [-1; 1] (unorm16 65535 -> 1.0)
+		Integer,		// kept integral, read with an int/uint shader input
+	};
+
+	template <typename T>
+	constexpr GLenum GLTypeOf() noexcept
+	{
+		if constexpr (std::is_same_v<T, float>)				return GL_FLOAT;
+		else if constexpr (std::is_same_v<T, Half>)			return GL_HALF_FLOAT;
+		else if constexpr (std::is_same_v<T, std::int8_t>)		return GL_BYTE;
+		else if constexpr (std::is_same_v<T, std::uint8_t>)	return GL_UNSIGNED_BYTE;
+		else if constexpr (std::is_same_v<T, std::int16_t>)	return GL_SHORT;
+		else if constexpr (std::is_same_v<T, std::uint16_t>)	return GL_UNSIGNED_SHORT;
+		else if constexpr (std::is_same_v<T, std::int32_t>)	return GL_INT;
+		else if constexpr (std::is_same_v<T, std::uint32_t>)	return GL_UNSIGNED_INT;
+		else static_assert(!sizeof(T), "GLTypeOf: the type has no matching GL vertex type");
+	}
+
+	// Compile-time description of a single vertex attribute
+	template <typename T, int Count, AttributeMode Mode = AttributeMode::Float>
+	struct VertexAttribute
+	{
+		static_assert(Count >= 1 && Count <= 4, "VertexAttribute: a vertex attribute has 1 to 4 components");
+		static_assert(Mode != AttributeMode::Integer || std::is_integral_v<T>, "VertexAttribute: integer attributes need an integral type");
+
+		using component_type = T;
+
+		static constexpr int			count{ Count };
+		static constexpr AttributeMode	mode{ Mode };
+		static constexpr GLenum			type{ GLTypeOf<T>() };
+		static constexpr std::size_t	size{ sizeof(T) * Count };
+	};
+
+	// Interleaved vertex format, the attribute locations follow the order of the pack.
+	// Stride and offsets are computed at compile time, so Apply() boils down
+	// to the very same glVertexAttribPointer calls one would write by hand
+	template <typename... Attributes>
+	class VertexLayout
+	{
+	public:
+		static constexpr std::size_t count{ sizeof...(Attributes) };
+		static constexpr std::size_t stride{ (Attributes::size + ... + 0) };
+
+		static constexpr std::array<std::size_t, count> offsets = []
+		{
+			std::array<std::size_t, count> result{};
+			std::size_t sizes[]{ Attributes::size... };
+			std::size_t offset{};
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				result[i] = offset;
+				offset += sizes[i];
+			}
+
+			return result;
+		}();
+
+		static_assert(stride % 4 == 0, "VertexLayout: the stride should be a multiple of 4 bytes");
+
+		// Describes and enables every attribute for the bound VAO and GL_ARRAY_BUFFER.
+		// firstLocation shifts all the locations, divisor makes them per-instance
+		static void Apply(unsigned int firstLocation = 0, unsigned int divisor = 0)
+		{
+			ApplyAll(firstLocation, divisor, std::index_sequence_for<Attributes...>{});
+		}
+
+	private:
+		template <std::size_t... Indices>
+		static void ApplyAll(unsigned int firstLocation, unsigned int divisor, std::index_sequence<Indices...>)
+		{
+			(ApplyOne<Attributes>(firstLocation + static_cast<unsigned int>(Indices), offsets[Indices], divisor), ...);
+		}
+
+		template <typename Attribute>
+		static void ApplyOne(unsigned int location, std::size_t offset, unsigned int divisor)
+		{
+			if constexpr (Attribute::mode == AttributeMode::Integer)
+				glVertexAttribIPointer(location, Attribute::count, Attribute::type, static_cast<GLsizei>(stride), (void*)offset);
+			else
+				glVertexAttribPointer(location, Attribute::count, Attribute::type,
+					Attribute::mode == AttributeMode::Normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(stride), (void*)offset);
+
+			glEnableVertexAttribArray(location);
+			if (divisor != 0)
+				glVertexAttribDivisor(location, divisor);
+		}
+	};
+}
@@ -0,0 +1,62 @@
+#include "VirtualFramebuffer.hpp"
+#include "Renderer.hpp"
+
+#include <algorithm>
+
+using namespace GameEngine;
+
+//						[CONSTRUCTORS]
+
+VirtualFramebuffer::VirtualFramebuffer(int baseWidth, int baseHeight, int windowWidth, int windowHeight)
+	: m_Target{ std::max(baseWidth, 1), std::max(baseHeight, 1), GL_NEAREST },
+	m_BaseWidth{ std::max(baseWidth, 1) }, m_BaseHeight{ std::max(baseHeight, 1) },
+	m_WindowWidth{ windowWidth }, m_WindowHeight{ windowHeight }, m_ResizePending{ true }
+{
+}
+
+
+//						[UTILITY]
+
+void VirtualFramebuffer::WindowResized(int windowWidth, int windowHeight)
+{
+	m_WindowWidth = windowWidth;
+	m_WindowHeight = windowHeight;
+	m_ResizePending = true;
+	m_LastResize = std::chrono::steady_clock::now();
+}
+
+void VirtualFramebuffer::Begin()
+{
+	const std::chrono::duration<double> sinceResize{ std::chrono::steady_clock::now() - m_LastResize };
+	if (m_ResizePending && sinceResize.count() >= resizeDebounce && m_WindowWidth > 0 && m_WindowHeight > 0)
+	{
+		// Fill the window at the factor the base resolution gets, the rest is under one texel
+		const int scale{ UpscaleFactor(m_BaseWidth, m_BaseHeight) };
+		m_Target.Resize(std::max(m_WindowWidth / scale, 1), std::max(m_WindowHeight / scale, 1));
+		m_ResizePending = false;
+	}
+
+	m_Target.Bind();
+}
+
+void VirtualFramebuffer::Present() const
+{
+	// Until the resize settles the old target is shown at whatever integer factor fits
+	const int scale{ UpscaleFactor(Width(), Height()) };
+	const int width{ Width() * scale };
+	const int height{ Height() * scale };
+	const int x{ (m_WindowWidth - width) / 2 };
+	const int y{ (m_WindowHeight - height) / 2 };
+
+	Renderer::BindOutputFramebuffer();
+	glViewport(0, 0, m_WindowWidth, m_WindowHeight);
+	if (width != m_WindowWidth || height != m_WindowHeight)
+		glClear(GL_COLOR_BUFFER_BIT);
+
+	m_Target.BlitToScreen(x, y, x + width, y + height, GL_NEAREST);
+}
+
+int VirtualFramebuffer::UpscaleFactor(int width, int height) const noexcept
+{
+	return std::max(std::min(m_WindowWidth / width, m_WindowHeight / height), 1);
+}
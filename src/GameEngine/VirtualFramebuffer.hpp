@@ -0,0 +1,55 @@
+#pragma once
+#include "RenderTarget.hpp"
+#include <chrono>
+
+namespace GameEngine
+{
+	// Low resolution scene target for pixel art. The scene is rendered at roughly
+	// baseWidth x baseHeight and upscaled to the window by the largest integer factor
+	// that fits, so texels stay square. The target is sized to fill the window at that
+	// factor and is only reallocated once the window stopped changing for a moment
+	class VirtualFramebuffer
+	{
+	public:
+		// Seconds the window size has to stay the same before the target is reallocated
+		static constexpr double resizeDebounce{ 0.2 };
+
+
+		//				[CONSTRUCTORS]
+
+		// Exceptions: [runtime_error]
+		VirtualFramebuffer(int baseWidth, int baseHeight, int windowWidth, int windowHeight);
+
+
+		//				[GETTERS]
+
+		int Width() const noexcept { return m_Target.Width(); }
+		int Height() const noexcept { return m_Target.Height(); }
+		float AspectRatio() const noexcept { return static_cast<float>(Width()) / static_cast<float>(Height()); }
+
+
+		//				[UTILITY]
+
+		// Call from the window resize callback, the target is resized lazily in Begin()
+		void WindowResized(int windowWidth, int windowHeight);
+
+		// Applies a settled resize and binds the target for the scene
+		// Exceptions: [runtime_error]
+		void Begin();
+
+		// Upscales the scene into the default framebuffer, the leftover border gets the clear color
+		void Present() const;
+
+	private:
+		RenderTarget m_Target;
+		int m_BaseWidth{};
+		int m_BaseHeight{};
+		int m_WindowWidth{};
+		int m_WindowHeight{};
+		bool m_ResizePending{};
+		std::chrono::steady_clock::time_point m_LastResize{};
+
+		// Integer upscale factor of a width x height image in the current window, at least 1
+		int UpscaleFactor(int width, int height) const noexcept;
+	};
+}
@@ -5,6 +5,20 @@
 #include "GameEngine/CameraOLD.hpp"
 #include "GameEngine/Camera2D.hpp"
 #include "GameEngine/Renderer.hpp"
+#include "GameEngine/VertexLayout.hpp"
+#include "GameEngine/VirtualFramebuffer.hpp"
+#include "GameEngine/DynamicResolution.hpp"
+#include "GameEngine/GpuProfiler.hpp"
+#include "GameEngine/ProfilerOverlay.hpp"
+#include "GameEngine/CpuProfiler.hpp"
+#include "GameEngine/FrameStats.hpp"
+#include "GameEngine/HitchDetector.hpp"
+#include "GameEngine/HeadlessContext.hpp"
+#include "GameEngine/StartupTimeline.hpp"
+#include "GameEngine/JobSystem.hpp"
+#include "GameEngine/Image.hpp"
+#include "GameEngine/AssetPack.hpp"
+#include "GameEngine/CookedTexture.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -15,11 +29,13 @@
 #include <format>
 #include <vector>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <chrono>
 
 namespace GameEngine
 {
 	static void ProcessInput(GLFWwindow* window);
-	static glm::mat4 Transform(glm::vec3 translation, glm::vec3 scale, glm::vec3 rotation);
 	void RenderObjects(const Shader& shader);
 
 	namespace WindowEvent
@@ -27,65 +43,186 @@ namespace GameEngine
 		static void Resize(GLFWwindow* window, int width, int height);
 		static void MouseMove(GLFWwindow* window, double xPos, double yPos);
 		static void MouseScroll(GLFWwindow* window, double xOffset, double yOffset);
+		static void Key(GLFWwindow* window, int key, int scanCode, int action, int mods);
 	}
 
-	const std::string ShaderPath	{ "src/shaders/" };
-	const std::string ResourcesPath	{ "resources/" };
 	const std::string vertBasic		{ ShaderPath + "basic.vert" };
 	const std::string fragBasic		{ ShaderPath + "basic.frag" };
 
 	Camera2D camera2D;
+	std::unique_ptr<VirtualFramebuffer> virtualFramebuffer;
+	std::unique_ptr<DynamicResolution> dynamicResolution;
+	std::unique_ptr<HeadlessContext> headlessContext;
 
+	bool showProfiler{};
 	float deltaTime{};
 	int windowWidth{};
 	int windowHeight{};
 
 	// Initializes the graphics routine
 	// Exceptions: [runtime_error]
-	static GLFWwindow* GraphicsInit(int winWidth, int winHeight)
+	GLFWwindow* GraphicsInit(int winWidth, int winHeight, bool headless)
 	{
-		if (glfwInit() == GLFW_FALSE)
-			throw std::runtime_error("GraphicsInit error: glfwInit() unsuccessful");
-
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		if (headless)
+		{
+			try
+			{
+				StartupTimeline::Phase phase{ "Headless context" };
+				headlessContext = std::make_unique<HeadlessContext>(winWidth, winHeight);
+				return nullptr;
+			}
+			catch (const std::runtime_error& except)
+			{
+				std::cout << except.what() << "\nFalling back to a hidden window\n";
+			}
+		}
 
-		GLFWwindow* mainWindow = glfwCreateWindow(winWidth, winHeight, "ArlekinGame", nullptr, nullptr);
-		if (mainWindow == nullptr)
 		{
-			glfwTerminate();
-			throw std::runtime_error("GraphicsInit error: failed co create a window");
+			StartupTimeline::Phase phase{ "glfwInit" };
+			if (glfwInit() == GLFW_FALSE)
+				throw std::runtime_error("GraphicsInit error: glfwInit() unsuccessful");
 		}
 
-		glfwMakeContextCurrent(mainWindow);
+		GLFWwindow* mainWindow{};
+		{
+			StartupTimeline::Phase phase{ "Window creation" };
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+			glfwWindowHint(GLFW_VISIBLE, headless ? GLFW_FALSE : GLFW_TRUE);
+
+			mainWindow = glfwCreateWindow(winWidth, winHeight, "ArlekinGame", nullptr, nullptr);
+			if (mainWindow == nullptr)
+			{
+				glfwTerminate();
+				throw std::runtime_error("GraphicsInit error: failed co create a window");
+			}
+
+			glfwMakeContextCurrent(mainWindow);
+		}
 
-		if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 		{
-			glfwTerminate();
-			throw std::runtime_error("GraphicsInit error: failed to load GLAD");
+			StartupTimeline::Phase phase{ "GLAD load" };
+			if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+			{
+				glfwTerminate();
+				throw std::runtime_error("GraphicsInit error: failed to load GLAD");
+			}
 		}
 
 		glViewport(0, 0, winWidth, winHeight);
 		return mainWindow;
 	}
 
+	bool GraphicsShouldClose(GLFWwindow* window)
+	{
+		return window != nullptr && glfwWindowShouldClose(window);
+	}
+
+	// Swaps the window buffers, headless it waits for the GPU like a synced swap would
+	void GraphicsPresent(GLFWwindow* window)
+	{
+		if (window == nullptr)
+		{
+			glFinish();
+			return;
+		}
+
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+	}
+
+	void GraphicsShutdown()
+	{
+		if (headlessContext)
+			headlessContext.reset();
+		else
+			glfwTerminate();
+	}
+
 
 	// Runs the main loop of a game
-	int Run(int winWidth, int winHeight)
+	int Run(int winWidth, int winHeight, const RunOptions& options)
 	{
+		PROFILE_THREAD("Main");
+		StartupTimeline& startup = StartupTimeline::Instance();
+
 		windowHeight = winHeight;
 		windowWidth = winWidth;
 
-		GLFWwindow* mainWindow = GraphicsInit(windowWidth, windowHeight);
-		glfwSetInputMode(mainWindow, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-		glfwSetFramebufferSizeCallback(mainWindow, WindowEvent::Resize);
-		glfwSetCursorPosCallback(mainWindow, WindowEvent::MouseMove);
-		glfwSetScrollCallback(mainWindow, WindowEvent::MouseScroll);
+		// Mapping the pack only reads its table of contents, the data is paged in when touched
+		std::unique_ptr<AssetPack> pack;
+		if (!options.assetPackPath.empty())
+		{
+			StartupTimeline::Phase phase{ "Asset pack open" };
+			pack = std::make_unique<AssetPack>(options.assetPackPath);
+		}
+
+		// Decoding and file reading need no GL context, they overlap the window and context creation.
+		// Cooked pack textures need no decode at all, they are uploaded from the mapping
+		const std::string containerName{ ResourcesPath + "container.jpg" };
+		const std::string faceName{ ResourcesPath + "awesomeface.png" };
+		auto isCooked = [&pack](const std::string& name) { return pack && pack->Contains(CookedTextureName(name)); };
+		auto loadImage = [&pack](const std::string& name)
+		{
+			return pack ? DecodeImage(pack->Data(name), 0, name) : LoadImage(name);
+		};
+
+		auto loaders = std::make_unique<JobSystem>(3);
+		std::future<Image> containerLoad;
+		std::future<Image> faceLoad;
+		if (!isCooked(containerName))
+		{
+			containerLoad = loaders->Submit([&loadImage, &containerName]()
+			{
+				StartupTimeline::Phase phase{ "Decode container.jpg", true };
+				return loadImage(containerName);
+			});
+		}
+		if (!isCooked(faceName))
+		{
+			faceLoad = loaders->Submit([&loadImage, &faceName]()
+			{
+				StartupTimeline::Phase phase{ "Decode awesomeface.png", true };
+				return loadImage(faceName);
+			});
+		}
 
-		glEnable(GL_DEPTH_TEST);
+		// The pack shader sources are compiled in place, there is nothing to read
+		std::future<ShaderSources> shaderLoad;
+		if (!pack)
+		{
+			shaderLoad = loaders->Submit([]()
+			{
+				StartupTimeline::Phase phase{ "Read shaders", true };
+				return ReadShaderSources(vertBasic, fragBasic);
+			});
+		}
+
+		GLFWwindow* mainWindow = GraphicsInit(windowWidth, windowHeight, options.headless);
+		if (mainWindow != nullptr)
+		{
+			glfwSetInputMode(mainWindow, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+			glfwSetFramebufferSizeCallback(mainWindow, WindowEvent::Resize);
+			glfwSetCursorPosCallback(mainWindow, WindowEvent::MouseMove);
+			glfwSetScrollCallback(mainWindow, WindowEvent::MouseScroll);
+			glfwSetKeyCallback(mainWindow, WindowEvent::Key);
+		}
+
+		std::uint64_t phaseBegin{ CpuProfiler::Now() };
+
+		Renderer::SetDepthMode(options.depthMode);
 		//glEnable(GL_CULL_FACE);
 
+		if (options.virtualWidth > 0 && options.virtualHeight > 0)
+			virtualFramebuffer = std::make_unique<VirtualFramebuffer>(options.virtualWidth, options.virtualHeight, windowWidth, windowHeight);
+		else if (options.frameBudgetMs > 0.0)
+		{
+			DynamicResolutionSettings settings{};
+			settings.frameBudgetMs = options.frameBudgetMs;
+			dynamicResolution = std::make_unique<DynamicResolution>(windowWidth, windowHeight, settings);
+		}
+
 		float cubeSingle[] =
 		{
 			-0.5f, 0.5f, 0.0f, 0.0f, 1.0f,
@@ -113,68 +250,184 @@ namespace GameEngine
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeEBO);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(0);
-
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(1);
+		// xyz + uv
+		using CubeLayout = VertexLayout<VertexAttribute<float, 3>, VertexAttribute<float, 2>>;
+		static_assert(CubeLayout::stride == 5 * sizeof(float));
+		CubeLayout::Apply();
 		glBindVertexArray(0);
 
 		camera2D = Camera2D{ { 0.0f, 0.0f, 3.0f }, (float)windowWidth / (float)windowHeight, 0.1f, 100.0f };
-
-		Timer<float> performanceTimer{};
-		Timer<float> globalTimer{};
-		Texture container{ ResourcesPath + "container.jpg" };
-		Texture face{ ResourcesPath + "awesomeface.png", GL_RGBA };
-
-		Shader shader{ vertBasic,   fragBasic };
-		shader.Use();
-		shader.SetInt("texSample1", 0);
-		shader.SetInt("texSample2", 1);
-
-		float lastFrame{};
-		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-		//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		while (!glfwWindowShouldClose(mainWindow))
+		startup.Record("Scene setup", phaseBegin, CpuProfiler::Now());
+
+		// Whatever the workers have not finished yet
+		phaseBegin = CpuProfiler::Now();
+		std::optional<Image> containerImage;
+		std::optional<Image> faceImage;
+		if (containerLoad.valid())
+			containerImage = containerLoad.get();
+		if (faceLoad.valid())
+			faceImage = faceLoad.get();
+		ShaderSources shaderSources{ pack ? ShaderSources{} : shaderLoad.get() };
+		startup.Record("Wait for loaders", phaseBegin, CpuProfiler::Now());
+
+		// The GL objects of the scene are released before the context goes away
 		{
-			performanceTimer.Reset();
-			//std::cout << camera2D;
-
-			float currentFrame = globalTimer.Elapsed();
-			deltaTime = currentFrame - lastFrame;
-			lastFrame = currentFrame;
-
-			ProcessInput(mainWindow);
-
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
-			//glm::mat4 view = camera.LookAt(camera.Position() + camera.Front());
-			//camera.Transform2D(glm::vec3{ 0.0f });
-
-			glm::mat4 boxModel = Transform(glm::vec3{ 0.0f }, glm::vec3{ 1.0f }, glm::vec3{ 0.0f });
-			//glm::mat4 camProj = glm::ortho(-(float)windowWidth/2.0f, (float)windowWidth/2.0f, -(float)windowHeight/2.0f, (float)windowHeight/2.0f, 0.1f, 100.0f);
-			//camProj = glm::mat4{ 1.0f };
-
+			// The loaders decompress the compressed cooked textures
+			phaseBegin = CpuProfiler::Now();
+			auto makeTexture = [&pack, &loaders](const std::optional<Image>& image, const std::string& name)
+			{
+				return image ? Texture{ *image } : LoadPackTexture(*pack, CookedTextureName(name), loaders.get());
+			};
+			Texture container{ makeTexture(containerImage, containerName) };
+			Texture face{ makeTexture(faceImage, faceName) };
+			loaders.reset();
+			startup.Record("Texture upload", phaseBegin, CpuProfiler::Now());
+
+			phaseBegin = CpuProfiler::Now();
+			Shader shader{ pack ? Shader{ *pack, vertBasic, fragBasic } : Shader{ shaderSources } };
 			shader.Use();
-			shader.SetMat4f("model", glm::value_ptr(boxModel));
-			shader.SetMat4f("view", glm::value_ptr(camera2D.View()));
-			shader.SetMat4f("projection", glm::value_ptr(camera2D.Projection()));
+			shader.SetInt("texSample1", 0);
+			shader.SetInt("texSample2", 1);
+			startup.Record("Shader compile", phaseBegin, CpuProfiler::Now());
+
+			// F1 shows the GPU times of the passes, bars on screen and numbers in the title
+			phaseBegin = CpuProfiler::Now();
+			GpuProfiler gpuProfiler{};
+			Overlay overlay{ ShaderPath };
+			const double frameBudgetMs{ options.frameBudgetMs > 0.0 ? options.frameBudgetMs : 1000.0 / 60.0 };
+			Timer<float> titleTimer{};
+
+			FrameStats frameStats{ frameBudgetMs };
+			Timer<float> statsFileTimer{};
+			constexpr float statsFilePeriod{ 10.0f };
+
+			std::unique_ptr<HitchDetector> hitchDetector;
+			if (!options.hitchDirectory.empty())
+				hitchDetector = std::make_unique<HitchDetector>(HitchSettings{ .directory = options.hitchDirectory });
+			startup.Record("Profiler setup", phaseBegin, CpuProfiler::Now());
+
+			Timer<float> performanceTimer{};
+			Timer<float> globalTimer{};
+
+			float lastFrame{};
+			bool firstFrame{ true };
+			int frameCount{};
+			glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+			//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+			while (!GraphicsShouldClose(mainWindow) && (options.frameLimit <= 0 || frameCount < options.frameLimit))
+			{
+				PROFILE_FRAME();
+				performanceTimer.Reset();
+				//std::cout << camera2D;
+
+				float currentFrame = globalTimer.Elapsed();
+				deltaTime = currentFrame - lastFrame;
+				lastFrame = currentFrame;
+
+				// The first delta is the loading time, not a frame
+				if (!firstFrame)
+				{
+					frameStats.Record(deltaTime * 1000.0);
+					if (hitchDetector)
+						hitchDetector->EndFrame(deltaTime * 1000.0, &gpuProfiler);
+				}
+				firstFrame = false;
+				if (!options.frameStatsPath.empty() && statsFileTimer.Elapsed() > statsFilePeriod)
+				{
+					// A report that can't be written is not worth stopping the game
+					try
+					{
+						frameStats.WriteReport(options.frameStatsPath);
+					}
+					catch (const std::runtime_error& except)
+					{
+						std::cout << except.what() << '\n';
+					}
+					statsFileTimer.Reset();
+				}
+
+				if (mainWindow != nullptr)
+					ProcessInput(mainWindow);
+
+				PROFILE_ZONE("Render");
+				gpuProfiler.BeginFrame();
+				gpuProfiler.BeginScope("scene");
+				if (virtualFramebuffer)
+					virtualFramebuffer->Begin();
+				else if (dynamicResolution)
+					dynamicResolution->Begin();
+				else
+					Renderer::BindOutputFramebuffer();
+				Renderer::Clear();
+
+				//glm::mat4 view = camera.LookAt(camera.Position() + camera.Front());
+				//camera.Transform2D(glm::vec3{ 0.0f });
+
+				glm::mat4 boxModel = Transform(glm::vec3{ 0.0f }, glm::vec3{ 1.0f }, glm::vec3{ 0.0f });
+				//glm::mat4 camProj = glm::ortho(-(float)windowWidth/2.0f, (float)windowWidth/2.0f, -(float)windowHeight/2.0f, (float)windowHeight/2.0f, 0.1f, 100.0f);
+				//camProj = glm::mat4{ 1.0f };
+
+				shader.Use();
+				shader.SetMat4f("model", glm::value_ptr(boxModel));
+				shader.SetMat4f("view", glm::value_ptr(camera2D.View()));
+				shader.SetMat4f("projection", glm::value_ptr(camera2D.Projection()));
 			
-			glBindVertexArray(cubeVAO);
-			container.Bind(GL_TEXTURE0);
-			face.Bind(GL_TEXTURE1);
-			RenderObjects(shader);
-			glBindVertexArray(0);
-
-			glfwSwapBuffers(mainWindow);
-			glfwPollEvents();
-			//std::cout << "FPS: [" << 1.0 / performanceTimer.Elapsed() << "]\n";
+				glBindVertexArray(cubeVAO);
+				container.Bind(GL_TEXTURE0);
+				face.Bind(GL_TEXTURE1);
+				RenderObjects(shader);
+				glBindVertexArray(0);
+				gpuProfiler.EndScope();
+
+				{
+					GpuProfiler::Scope upscaleScope{ gpuProfiler, "upscale" };
+					if (virtualFramebuffer)
+						virtualFramebuffer->Present();
+					else if (dynamicResolution)
+						dynamicResolution->Present(performanceTimer.Elapsed() * 1000.0);
+				}
+
+				if (showProfiler)
+				{
+					GpuProfiler::Scope overlayScope{ gpuProfiler, "overlay" };
+					DrawGpuProfile(overlay, gpuProfiler, frameBudgetMs, 10.0f, 10.0f);
+					DrawFrameStats(overlay, frameStats, static_cast<float>(windowWidth) - 310.0f, 10.0f);
+					overlay.Draw(windowWidth, windowHeight);
+
+					if (mainWindow != nullptr && titleTimer.Elapsed() > 0.5f)
+					{
+						const std::string title{ FormatFrameStats(frameStats) + " || GPU " + FormatGpuProfile(gpuProfiler) };
+						glfwSetWindowTitle(mainWindow, title.c_str());
+						titleTimer.Reset();
+					}
+				}
+				gpuProfiler.EndFrame();
+
+				{
+					PROFILE_ZONE("Swap");
+					GraphicsPresent(mainWindow);
+				}
+
+				if (frameCount == 0)
+				{
+					startup.FirstFrame();
+					frameStats.TimeToFirstFrameMs(startup.TimeToFirstFrameMs());
+					std::cout << startup.Report();
+				}
+				++frameCount;
+				//std::cout << "FPS: [" << 1.0 / performanceTimer.Elapsed() << "]\n";
+			}
+
+			glDeleteVertexArrays(1, &cubeVAO);
+			glDeleteBuffers(1, &cubeVBO);
+			virtualFramebuffer.reset();
+			dynamicResolution.reset();
+
+			if (!options.frameStatsPath.empty())
+				frameStats.WriteReport(options.frameStatsPath);
 		}
 
-		glDeleteVertexArrays(1, &cubeVAO);
-		glDeleteBuffers(1, &cubeVBO);
-
-		glfwTerminate();
+		GraphicsShutdown();
 		return 0;
 	}
 
@@ -189,7 +442,7 @@ namespace GameEngine
 	// translation - vector by which you want to change position
 	// scale - vector that represents scaling in each coordinates
 	// rotation - angles in radians (!) that represents rotation around corresponding axis
-	static glm::mat4 Transform(glm::vec3 translation, glm::vec3 scale, glm::vec3 rotation)
+	glm::mat4 Transform(glm::vec3 translation, glm::vec3 scale, glm::vec3 rotation)
 	{
 		glm::mat4 transform = glm::mat4(1.0f);
 
@@ -233,6 +486,11 @@ namespace GameEngine
 		windowHeight = height;
 		windowWidth = width;
 		camera2D.AspectRatio((float)width / (float)height);
+
+		if (virtualFramebuffer)
+			virtualFramebuffer->WindowResized(width, height);
+		if (dynamicResolution)
+			dynamicResolution->WindowResized(width, height);
 	}
 
 	// Mouse movement callback for the window
@@ -254,6 +512,40 @@ namespace GameEngine
 		//camera.Rotate(xDiff, yDiff);
 	}
 
+	static void WindowEvent::Key(GLFWwindow* window, int key, int, int action, int)
+	{
+#ifndef GAMEENGINE_PROFILER_DISABLED
+		// F2 saves the last CPU frames for chrome://tracing or Perfetto
+		if (key == GLFW_KEY_F2 && action == GLFW_PRESS)
+		{
+			const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			const std::string path{ std::format("trace_{}.json", seconds) };
+
+			// Exceptions must not cross the GLFW callback
+			try
+			{
+				CpuProfiler::Instance().WriteChromeTrace(path, 120);
+				std::cout << "CPU trace saved to " << path << '\n';
+			}
+			catch (const std::runtime_error& except)
+			{
+				std::cout << except.what() << '\n';
+			}
+		}
+
+		// F3 prints the zone totals of the last 120 frames, with hardware counters when enabled
+		if (key == GLFW_KEY_F3 && action == GLFW_PRESS)
+			std::cout << FormatZoneSummary(CpuProfiler::Instance().SummarizeZones(CpuProfiler::Instance().FrameStart(120)));
+#endif
+
+		if (key == GLFW_KEY_F1 && action == GLFW_PRESS)
+		{
+			showProfiler = !showProfiler;
+			if (!showProfiler)
+				glfwSetWindowTitle(window, "ArlekinGame");
+		}
+	}
+
 	static void WindowEvent::MouseScroll(GLFWwindow* window, double xOffset, double yOffset)
 	{
 		static float scale{ 1.0f };
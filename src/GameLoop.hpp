@@ -1,8 +1,55 @@
 #pragma once
+#include "GameEngine/Renderer.hpp"
 #include <glad/glad.h>
 #include <glfw3.h>
+#include <glm/glm.hpp>
+#include <string>
 
 namespace GameEngine
 {
-	int Run(int winWidth, int winHeight);
+	inline const std::string ShaderPath		{ "src/shaders/" };
+	inline const std::string ResourcesPath	{ "resources/" };
+
+	// headless: renders without a window through a HeadlessContext and returns nullptr,
+	// falls back to a hidden window when EGL is not there
+	GLFWwindow* GraphicsInit(int winWidth, int winHeight, bool headless = false);
+
+	// Window or not, these do the right thing with what GraphicsInit returned
+	bool GraphicsShouldClose(GLFWwindow* window);
+	void GraphicsPresent(GLFWwindow* window);
+	void GraphicsShutdown();
+
+	struct RunOptions
+	{
+		// > 0 renders the scene at that low resolution and upscales it by an integer factor (see VirtualFramebuffer)
+		int virtualWidth{};
+		int virtualHeight{};
+
+		// > 0 scales the render resolution to hold that frame time (see DynamicResolution).
+		// Ignored with a virtual resolution
+		double frameBudgetMs{};
+
+		// Not empty: the frame time report (see FrameStats) is written there every few seconds and on exit
+		std::string frameStatsPath;
+
+		// Hitches are saved there (see HitchDetector), empty turns the detection off
+		std::string hitchDirectory{ "hitches" };
+
+		// No window, the frames go to an offscreen target (see HeadlessContext)
+		bool headless{};
+
+		// > 0 exits after that many frames, headless runs need it to end
+		int frameLimit{};
+
+		// Not empty: the textures and shaders come from that pack (see AssetPack) instead of loose files
+		std::string assetPackPath;
+
+		// Everything on screen is 2D, by default the draw order decides what is on top
+		Renderer::DepthMode depthMode{ Renderer::DepthMode::Painter2D };
+	};
+
+	int Run(int winWidth, int winHeight, const RunOptions& options = {});
+
+	// Model matrix: translation, then scale, then rotation around x, y and z in radians (!)
+	glm::mat4 Transform(glm::vec3 translation, glm::vec3 scale, glm::vec3 rotation);
 }
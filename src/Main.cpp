@@ -1,10 +1,118 @@
 #include "Main.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
 	try
 	{
-		GameEngine::Run(950	, 600);
+		// --perf-counters anywhere collects hardware counters (Linux perf_event_open) for the profiler zones,
+		// --headless anywhere renders offscreen without a window, for benchmarks and CI,
+		// --depth-mode painter|split|3d anywhere picks how the game and the sprite benchmark resolve overlaps
+		bool headless{};
+		GameEngine::Renderer::DepthMode depthMode{ GameEngine::Renderer::DepthMode::Painter2D };
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option{ argv[i] };
+			int consumed{ 1 };
+			if (option == "--perf-counters")
+			{
+				if (!GameEngine::PerfCounters::Enable())
+					std::cout << "Hardware performance counters are not available\n";
+			}
+			else if (option == "--headless")
+				headless = true;
+			else if (option == "--depth-mode" && i + 1 < argc)
+			{
+				std::optional<GameEngine::Renderer::DepthMode> mode = GameEngine::Renderer::ParseDepthMode(argv[i + 1]);
+				if (!mode)
+					throw std::runtime_error(std::string{ "Unknown depth mode: " } + argv[i + 1]);
+
+				depthMode = *mode;
+				consumed = 2;
+			}
+			else
+				continue;
+
+			std::copy(argv + i + consumed, argv + argc, argv + i);
+			argc -= consumed;
+			--i;
+		}
+
+		// --bench-sprites [count] [backend] compares the sprite renderer backends instead of running the game
+		if (argc > 1 && std::string{ argv[1] } == "--bench-sprites")
+		{
+			int spriteCount = argc > 2 ? std::stoi(argv[2]) : 100000;
+			if (argc > 3)
+			{
+				std::optional<GameEngine::SpriteBackend> backend = GameEngine::ParseSpriteBackend(argv[3]);
+				if (!backend)
+					throw std::runtime_error(std::string{ "Unknown sprite backend: " } + argv[3]);
+
+				return GameEngine::RunSpriteBenchmark(950, 600, spriteCount, 300, { &*backend, 1 }, headless, depthMode);
+			}
+
+			return GameEngine::RunSpriteBenchmark(950, 600, spriteCount, 300, GameEngine::AllSpriteBackends, headless, depthMode);
+		}
+
+		// --pack-assets [path] packs the resources and shaders into one file (assets.pak by default) instead of running the game
+		if (argc > 1 && std::string{ argv[1] } == "--pack-assets")
+		{
+			const std::string packPath{ argc > 2 ? argv[2] : "assets.pak" };
+
+			GameEngine::AssetPackWriter writer{};
+			writer.AddDirectory(GameEngine::ResourcesPath);
+			writer.AddDirectory(GameEngine::ShaderPath);
+			writer.Write(packPath);
+
+			std::cout << writer.Count() << " assets packed into " << packPath << '\n';
+			return 0;
+		}
+
+		// Game options, a value may follow each of them:
+		// --virtual-res [WIDTHxHEIGHT] renders pixel art at a low resolution, 480x270 by default
+		// --dynamic-res [budget ms] lowers the render resolution when the GPU cannot hold the frame budget
+		// --frame-stats [path] keeps writing the frame time report, frame_stats.txt by default
+		// --no-hitch-dumps turns off saving the profiler data around hitches
+		// --frames [count] exits after that many frames, 600 by default and when headless
+		// --asset-pack [path] loads the textures and shaders from a pack made by --pack-assets, assets.pak by default
+		GameEngine::RunOptions options{};
+		options.headless = headless;
+		options.depthMode = depthMode;
+		options.frameLimit = headless ? 600 : 0;
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option{ argv[i] };
+			const bool hasValue{ i + 1 < argc && std::string{ argv[i + 1] }.rfind("--", 0) != 0 };
+
+			if (option == "--virtual-res")
+			{
+				options.virtualWidth = 480;
+				options.virtualHeight = 270;
+				if (hasValue)
+				{
+					const std::string resolution{ argv[++i] };
+					const std::size_t separator{ resolution.find('x') };
+					if (separator == std::string::npos)
+						throw std::runtime_error("Virtual resolution has to be WIDTHxHEIGHT: " + resolution);
+
+					options.virtualWidth = std::stoi(resolution.substr(0, separator));
+					options.virtualHeight = std::stoi(resolution.substr(separator + 1));
+				}
+			}
+			else if (option == "--dynamic-res")
+				options.frameBudgetMs = hasValue ? std::stod(argv[++i]) : 1000.0 / 60.0;
+			else if (option == "--frame-stats")
+				options.frameStatsPath = hasValue ? argv[++i] : "frame_stats.txt";
+			else if (option == "--no-hitch-dumps")
+				options.hitchDirectory.clear();
+			else if (option == "--frames")
+				options.frameLimit = hasValue ? std::stoi(argv[++i]) : 600;
+			else if (option == "--asset-pack")
+				options.assetPackPath = hasValue ? argv[++i] : "assets.pak";
+			else
+				throw std::runtime_error("Unknown option: " + option);
+		}
+
+		GameEngine::Run(950	, 600, options);
 	}
 
 	catch (const std::runtime_error& except)
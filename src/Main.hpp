@@ -1,4 +1,9 @@
 #pragma once
 #include "GameLoop.hpp"
+#include "SpriteBenchmark.hpp"
+#include "GameEngine/PerfCounters.hpp"
+#include "GameEngine/AssetPack.hpp"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <string>
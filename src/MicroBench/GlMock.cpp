@@ -0,0 +1,48 @@
+#include "GlMock.hpp"
+
+#include <glad/glad.h>
+
+namespace GameEngine
+{
+	static std::size_t mockCalls{};
+
+	static GLuint APIENTRY MockCreate(GLenum) { ++mockCalls; return 1; }
+	static GLuint APIENTRY MockCreateProgram() { ++mockCalls; return 1; }
+	static void APIENTRY MockShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { ++mockCalls; }
+	static void APIENTRY MockObject(GLuint) { ++mockCalls; }
+	static void APIENTRY MockAttach(GLuint, GLuint) { ++mockCalls; }
+	static void APIENTRY MockStatus(GLuint, GLenum, GLint* value) { ++mockCalls; *value = GL_TRUE; }
+	static void APIENTRY MockInfoLog(GLuint, GLsizei, GLsizei*, GLchar* log) { ++mockCalls; log[0] = '\0'; }
+	static GLint APIENTRY MockUniformLocation(GLuint, const GLchar* name) { ++mockCalls; return name[0]; }
+	static void APIENTRY MockUniform1i(GLint, GLint) { ++mockCalls; }
+	static void APIENTRY MockUniform1f(GLint, GLfloat) { ++mockCalls; }
+	static void APIENTRY MockUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) { ++mockCalls; }
+	static void APIENTRY MockUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) { ++mockCalls; }
+
+	void InstallGlMock() noexcept
+	{
+		glad_glCreateShader = MockCreate;
+		glad_glCreateProgram = MockCreateProgram;
+		glad_glShaderSource = MockShaderSource;
+		glad_glCompileShader = MockObject;
+		glad_glDeleteShader = MockObject;
+		glad_glLinkProgram = MockObject;
+		glad_glUseProgram = MockObject;
+		glad_glAttachShader = MockAttach;
+		glad_glGetShaderiv = MockStatus;
+		glad_glGetProgramiv = MockStatus;
+		glad_glGetShaderInfoLog = MockInfoLog;
+		glad_glGetProgramInfoLog = MockInfoLog;
+		glad_glGetUniformLocation = MockUniformLocation;
+		glad_glUniform1i = MockUniform1i;
+		glad_glUniform1f = MockUniform1f;
+		glad_glUniform4f = MockUniform4f;
+		glad_glUniformMatrix4fv = MockUniformMatrix4fv;
+		mockCalls = 0;
+	}
+
+	std::size_t GlMockCalls() noexcept
+	{
+		return mockCalls;
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+namespace GameEngine
+{
+	// Points the GLAD function pointers used by Shader at stand-ins that do nothing,
+	// so the CPU side of the shader and uniform code runs without a context.
+	// Compiles and links always succeed
+	void InstallGlMock() noexcept;
+
+	// Calls that reached the stand-ins since the installation
+	std::size_t GlMockCalls() noexcept;
+}
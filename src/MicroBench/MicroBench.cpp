@@ -0,0 +1,159 @@
+#include "MicroBench.hpp"
+#include "../Timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+namespace GameEngine
+{
+	static std::string FormatHeader()
+	{
+		return std::format("{:<36}{:>12}{:>10}{:>12}{:>12}\n", "benchmark", "median ns", "MAD ns", "min ns", "iterations");
+	}
+
+	static std::string FormatRow(const MicroResult& result)
+	{
+		return std::format("{:<36}{:>12.2f}{:>10.2f}{:>12.2f}{:>12}\n", result.name, result.medianNs, result.madNs, result.minNs, result.iterations);
+	}
+
+	double Median(std::vector<double> values)
+	{
+		if (values.empty())
+			return 0.0;
+
+		const std::size_t middle{ values.size() / 2 };
+		std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle), values.end());
+		if (values.size() % 2 != 0)
+			return values[middle];
+
+		const double upper{ values[middle] };
+		return (*std::max_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle)) + upper) / 2.0;
+	}
+
+	double MedianAbsoluteDeviation(const std::vector<double>& values, double median)
+	{
+		std::vector<double> deviations;
+		deviations.reserve(values.size());
+		for (double value : values)
+			deviations.push_back(std::abs(value - median));
+
+		return Median(std::move(deviations));
+	}
+
+	void MicroBench::Add(std::string name, std::function<void(std::size_t iterations)> body)
+	{
+		m_Entries.push_back({ std::move(name), std::move(body) });
+	}
+
+	std::vector<MicroResult> MicroBench::Run(const MicroSettings& settings, const std::string& filter) const
+	{
+		std::vector<MicroResult> results;
+		std::cout << FormatHeader();
+		for (const Entry& entry : m_Entries)
+		{
+			if (!filter.empty() && entry.name.find(filter) == std::string::npos)
+				continue;
+
+			Timer<double> timer{};
+
+			// Doubles the iteration count until a repetition is long enough to time, this also warms up
+			std::size_t iterations{ 1 };
+			double warmup{};
+			for (;;)
+			{
+				timer.Reset();
+				entry.body(iterations);
+				const double elapsed{ timer.Elapsed() };
+				warmup += elapsed;
+
+				if (elapsed >= settings.repetitionSeconds)
+					break;
+				iterations *= 2;
+			}
+
+			while (warmup < settings.warmupSeconds)
+			{
+				timer.Reset();
+				entry.body(iterations);
+				warmup += timer.Elapsed();
+			}
+
+			std::vector<double> samples;
+			samples.reserve(static_cast<std::size_t>(settings.repetitions));
+			for (int repetition = 0; repetition < settings.repetitions; ++repetition)
+			{
+				timer.Reset();
+				entry.body(iterations);
+				samples.push_back(timer.Elapsed() * 1.0e9 / static_cast<double>(iterations));
+			}
+
+			MicroResult& result = results.emplace_back();
+			result.name = entry.name;
+			result.medianNs = Median(samples);
+			result.madNs = MedianAbsoluteDeviation(samples, result.medianNs);
+			result.minNs = *std::min_element(samples.begin(), samples.end());
+			result.iterations = iterations;
+			result.repetitions = settings.repetitions;
+
+			std::cout << FormatRow(result) << std::flush;
+		}
+
+		return results;
+	}
+
+	std::string FormatMicroResults(const std::vector<MicroResult>& results)
+	{
+		std::string table{ FormatHeader() };
+		for (const MicroResult& result : results)
+			table += FormatRow(result);
+
+		return table;
+	}
+
+	void WriteMicroBaseline(const std::string& path, const std::vector<MicroResult>& results)
+	{
+		std::ofstream file{ path };
+		if (!file)
+			throw std::runtime_error("WriteMicroBaseline error: can't open " + path);
+
+		for (const MicroResult& result : results)
+			file << std::format("{} {:.3f}\n", result.name, result.medianNs);
+	}
+
+	std::vector<std::string> FindMicroRegressions(const std::string& baselinePath, const std::vector<MicroResult>& results, double threshold)
+	{
+		std::ifstream file{ baselinePath };
+		if (!file)
+			throw std::runtime_error("FindMicroRegressions error: can't open " + baselinePath);
+
+		std::map<std::string, double> baseline;
+		for (std::string line; std::getline(file, line);)
+		{
+			const std::size_t separator{ line.rfind(' ') };
+			if (separator != std::string::npos && separator > 0)
+				baseline[line.substr(0, separator)] = std::stod(line.substr(separator + 1));
+		}
+
+		std::vector<std::string> regressions;
+		for (const MicroResult& result : results)
+		{
+			const auto found = baseline.find(result.name);
+			if (found == baseline.end())
+				continue;
+
+			const double limit{ found->second * (1.0 + threshold) };
+			if (result.medianNs > limit && result.medianNs - found->second > 3.0 * result.madNs)
+			{
+				regressions.push_back(std::format("{}: {:.2f} ns, baseline {:.2f} ns (+{:.1f}%)",
+					result.name, result.medianNs, found->second, (result.medianNs / found->second - 1.0) * 100.0));
+			}
+		}
+
+		return regressions;
+	}
+}
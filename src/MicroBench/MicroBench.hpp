@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+	inline const void* volatile keepValueSink{};
+
+	// Keeps the compiler from optimizing away a value the benchmark computed
+	template <typename T>
+	void KeepValue(const T& value) noexcept
+	{
+		keepValueSink = &value;
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+	}
+
+	struct MicroSettings
+	{
+		double warmupSeconds{ 0.05 };
+		double repetitionSeconds{ 0.01 };	// the iteration count is raised until a repetition lasts that long
+		int repetitions{ 31 };
+	};
+
+	// Nanoseconds per iteration over the repetitions
+	struct MicroResult
+	{
+		std::string name;
+		double medianNs{};
+		double madNs{};				// median absolute deviation from the median
+		double minNs{};
+		std::size_t iterations{};	// per repetition
+		int repetitions{};
+	};
+
+	// Median and MAD ignore the outliers a busy machine produces,
+	// the mean and the standard deviation would follow them
+	double Median(std::vector<double> values);
+	double MedianAbsoluteDeviation(const std::vector<double>& values, double median);
+
+	// Registry of microbenchmarks. The body runs its operation the given number of times
+	class MicroBench
+	{
+	public:
+		//				[UTILITY]
+
+		void Add(std::string name, std::function<void(std::size_t iterations)> body);
+
+		// Runs the benchmarks whose name contains filter, all of them when it is empty
+		std::vector<MicroResult> Run(const MicroSettings& settings, const std::string& filter = {}) const;
+
+	private:
+		struct Entry
+		{
+			std::string name;
+			std::function<void(std::size_t)> body;
+		};
+
+		std::vector<Entry> m_Entries;
+	};
+
+	std::string FormatMicroResults(const std::vector<MicroResult>& results);
+
+	// Baseline file: one "name median_ns" line per benchmark, the name may have spaces
+	// Exceptions: [runtime_error]
+	void WriteMicroBaseline(const std::string& path, const std::vector<MicroResult>& results);
+
+	// Results slower than the baseline median by more than threshold (0.1 = 10%) and by more than
+	// three MADs, with a line per regression. Benchmarks missing from the baseline are skipped
+	// Exceptions: [runtime_error]
+	std::vector<std::string> FindMicroRegressions(const std::string& baselinePath, const std::vector<MicroResult>& results, double threshold);
+}
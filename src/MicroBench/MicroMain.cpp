@@ -0,0 +1,173 @@
+#include "MicroBench.hpp"
+#include "GlMock.hpp"
+#include "../GameLoop.hpp"
+#include "../GameEngine/Camera2D.hpp"
+#include "../GameEngine/Shader.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace GameEngine
+{
+	// Gives the benchmarks access to the protected Camera::Transform
+	class CameraProbe final : public Camera
+	{
+	public:
+		using Camera::Transform;
+
+		void Position(const glm::vec3& newPosition) override { m_Position = newPosition; }
+		void ClipDistance(float newNearPlane, float newFarPlane) override { m_NearPlane = newNearPlane; m_FarPlane = newFarPlane; }
+		void Move(const glm::vec3& movementVector) override { m_Position += movementVector; }
+
+	private:
+		void UpdateViewMatrix() override {}
+		void UpdateProjectionMatrix() override {}
+	};
+
+	// New kernels (affine 2D transforms, SIMD batches) get their entry here next to the code they replace
+	static void RegisterBenchmarks(MicroBench& bench)
+	{
+		bench.Add("GameEngine::Transform", [](std::size_t iterations)
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				const float t{ static_cast<float>(i & 1023) * 0.001f };
+				KeepValue(Transform({ t, -t, 0.0f }, { 1.0f, 2.0f, 1.0f }, { 0.0f, 0.0f, t }));
+			}
+		});
+
+		bench.Add("Camera::Transform", [](std::size_t iterations)
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				const float t{ static_cast<float>(i & 1023) * 0.001f };
+				KeepValue(CameraProbe::Transform({ t, -t, 3.0f }));
+			}
+		});
+
+		bench.Add("Camera2D::UpdateViewMatrix", [](std::size_t iterations)
+		{
+			Camera2D camera{ { 0.0f, 0.0f, 3.0f }, 16.0f / 9.0f, 0.1f, 100.0f };
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				camera.Position({ static_cast<float>(i & 1023) * 0.001f, 0.0f, 3.0f });
+				KeepValue(camera.View());
+			}
+		});
+
+		bench.Add("Camera2D::UpdateProjectionMatrix", [](std::size_t iterations)
+		{
+			Camera2D camera{ { 0.0f, 0.0f, 3.0f }, 16.0f / 9.0f, 0.1f, 100.0f };
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				camera.AspectRatio(1.0f + static_cast<float>(i & 1023) * 0.001f);
+				KeepValue(camera.Projection());
+			}
+		});
+
+		bench.Add("Camera2D::Move", [](std::size_t iterations)
+		{
+			Camera2D camera{ { 0.0f, 0.0f, 3.0f }, 16.0f / 9.0f, 0.1f, 100.0f };
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				camera.Move(i % 2 == 0 ? glm::vec3{ 0.01f, 0.0f, 0.0f } : glm::vec3{ -0.01f, 0.0f, 0.0f });
+				KeepValue(camera.View());
+			}
+		});
+
+		// The GL side is mocked, what is left is the name strings and the call overhead
+		auto shader = std::make_shared<Shader>(ShaderPath + "basic.vert", ShaderPath + "basic.frag");
+
+		bench.Add("Shader::SetInt (mock GL)", [shader](std::size_t iterations)
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+				shader->SetInt("texSample1", static_cast<int>(i));
+		});
+
+		bench.Add("Shader::SetFloat4 (mock GL)", [shader](std::size_t iterations)
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+				shader->SetFloat4("tint", 1.0f, 0.5f, 0.25f, static_cast<float>(i & 1));
+		});
+
+		bench.Add("Shader::SetMat4f (mock GL)", [shader](std::size_t iterations)
+		{
+			const glm::mat4 matrix{ 1.0f };
+			for (std::size_t i = 0; i < iterations; ++i)
+				shader->SetMat4f("projection", glm::value_ptr(matrix));
+		});
+	}
+}
+
+// Engine microbenchmarks, options:
+// --filter text               runs only the benchmarks whose name contains the text
+// --repetitions N             timed repetitions per benchmark, 31 by default
+// --baseline path             fails when a median is slower than the stored one by more than the threshold
+// --threshold fraction        allowed slowdown against the baseline, 0.1 (10%) by default
+// --save-baseline path        stores the medians of this run as the new baseline
+int main(int argc, char* argv[])
+{
+	try
+	{
+		GameEngine::MicroSettings settings{};
+		std::string filter;
+		std::string baselinePath;
+		std::string saveBaselinePath;
+		double threshold{ 0.1 };
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option{ argv[i] };
+			if (i + 1 >= argc)
+				throw std::runtime_error("Missing value of " + option);
+			const std::string value{ argv[++i] };
+
+			if (option == "--filter")
+				filter = value;
+			else if (option == "--repetitions")
+				settings.repetitions = std::stoi(value);
+			else if (option == "--baseline")
+				baselinePath = value;
+			else if (option == "--threshold")
+				threshold = std::stod(value);
+			else if (option == "--save-baseline")
+				saveBaselinePath = value;
+			else
+				throw std::runtime_error("Unknown option: " + option);
+		}
+
+		GameEngine::InstallGlMock();
+
+		GameEngine::MicroBench bench{};
+		GameEngine::RegisterBenchmarks(bench);
+		const std::vector<GameEngine::MicroResult> results = bench.Run(settings, filter);
+
+		if (!saveBaselinePath.empty())
+		{
+			GameEngine::WriteMicroBaseline(saveBaselinePath, results);
+			std::cout << "Baseline saved to " << saveBaselinePath << '\n';
+		}
+
+		if (!baselinePath.empty())
+		{
+			const std::vector<std::string> regressions = GameEngine::FindMicroRegressions(baselinePath, results, threshold);
+			for (const std::string& regression : regressions)
+				std::cout << "REGRESSION " << regression << '\n';
+
+			if (!regressions.empty())
+				return 1;
+			std::cout << "No regressions against " << baselinePath << '\n';
+		}
+	}
+
+	catch (const std::exception& except)
+	{
+		std::cout << "Microbenchmarks failed:\n" << except.what() << std::endl;
+		return 2;
+	}
+
+	return 0;
+}
@@ -0,0 +1,166 @@
+#include "SpriteBenchmark.hpp"
+#include "GameLoop.hpp"
+#include "Timer.hpp"
+#include "GameEngine/Camera2D.hpp"
+#include "GameEngine/SpriteRenderer.hpp"
+#include "GameEngine/SpriteQueue.hpp"
+#include "GameEngine/JobSystem.hpp"
+#include "GameEngine/Renderer.hpp"
+#include "GameEngine/Texture.hpp"
+#include "GameEngine/GpuProfiler.hpp"
+#include "GameEngine/CpuProfiler.hpp"
+
+#include <iostream>
+#include <format>
+#include <random>
+#include <vector>
+
+namespace GameEngine
+{
+	// Scatters the sprites over the visible area of a camera with the given aspect ratio
+	static std::vector<Sprite> GenerateSprites(int spriteCount, float aspectRatio)
+	{
+		std::mt19937 generator{ 26 };
+		std::uniform_real_distribution<float> xDist{ -aspectRatio, aspectRatio };
+		std::uniform_real_distribution<float> yDist{ -1.0f, 1.0f };
+		std::uniform_real_distribution<float> sizeDist{ 0.02f, 0.08f };
+		std::uniform_real_distribution<float> angleDist{ 0.0f, 6.2831853f };
+		std::uniform_int_distribution<int> colorDist{ 128, 255 };
+
+		std::vector<Sprite> sprites(static_cast<std::size_t>(spriteCount));
+		for (Sprite& sprite : sprites)
+		{
+			float size = sizeDist(generator);
+
+			sprite.position = { xDist(generator), yDist(generator), 0.0f };
+			sprite.size = { size, size };
+			sprite.rotation = angleDist(generator);
+			sprite.tint = PackColor(
+				static_cast<std::uint8_t>(colorDist(generator)),
+				static_cast<std::uint8_t>(colorDist(generator)),
+				static_cast<std::uint8_t>(colorDist(generator)));
+		}
+
+		return sprites;
+	}
+
+	int RunSpriteBenchmark(int winWidth, int winHeight, int spriteCount, int frameCount, std::span<const SpriteBackend> backends, bool headless,
+		Renderer::DepthMode depthMode)
+	{
+		GLFWwindow* window = GraphicsInit(winWidth, winHeight, headless);
+		if (window != nullptr)
+			glfwSwapInterval(0);
+
+		Renderer::SetDepthMode(depthMode);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+
+		// The texture is released before the context goes away
+		{
+			const float aspectRatio{ (float)winWidth / (float)winHeight };
+			Camera2D camera{ { 0.0f, 0.0f, 3.0f }, aspectRatio, 0.1f, 100.0f };
+			Texture texture{ ResourcesPath + "awesomeface.png", GL_RGBA };
+			std::vector<Sprite> sprites = GenerateSprites(spriteCount, aspectRatio);
+			JobSystem jobs{};
+			SpriteQueue queue{};
+			queue.VisibleArea(SpriteQueue::VisibleArea(camera.View(), camera.Projection()));
+
+			std::cout << std::format("Sprite benchmark: {} sprites, {} frames, {} depth mode\n", spriteCount, frameCount, Renderer::ToString(depthMode));
+			std::cout << std::format("{:<14}{:>12}{:>12}{:>12}{:>12}{:>12}{:>14}\n", "backend", "sort ms", "cpu ms", "gpu ms", "frame ms", "draws", "KiB/frame");
+
+			constexpr int warmupFrames{ 10 };
+			for (SpriteBackend backend : backends)
+			{
+				if (depthMode != Renderer::DepthMode::Painter2D && !KeepsDepth(backend))
+				{
+					std::cout << std::format("{:<14}skipped, it has no depth\n", ToString(backend));
+					continue;
+				}
+
+				std::unique_ptr<SpriteRenderer> renderer = CreateSpriteRenderer(backend, ShaderPath);
+				GpuProfiler gpuProfiler{};
+				std::uint64_t measuredSince{};
+
+				Timer<double> sortTimer{};
+				Timer<double> cpuTimer{};
+				Timer<double> frameTimer{};
+				double sortTotal{};
+				double cpuTotal{};
+				double frameTotal{};
+
+				for (int frame = -warmupFrames; frame < frameCount && !GraphicsShouldClose(window); ++frame)
+				{
+					if (frame == 0)
+					{
+						renderer->ResetStats();
+						gpuProfiler.ResetStats();
+						measuredSince = CpuProfiler::Now();
+					}
+					PROFILE_FRAME();
+					gpuProfiler.BeginFrame();
+
+					{
+						PROFILE_ZONE("Transform update");
+						for (Sprite& sprite : sprites)
+							sprite.rotation += 0.01f;
+					}
+
+					frameTimer.Reset();
+					Renderer::BindOutputFramebuffer();
+					Renderer::Clear();
+					texture.Bind(GL_TEXTURE0);
+
+					sortTimer.Reset();
+					queue.Clear();
+					{
+						PROFILE_ZONE("Cull");
+						for (std::size_t i = 0; i < sprites.size(); ++i)
+							queue.Submit(sprites[i], static_cast<std::uint8_t>(i % 4), 0, texture.Alpha());
+					}
+					queue.Sort(&jobs);
+					double sortTime = sortTimer.Elapsed();
+
+					cpuTimer.Reset();
+					gpuProfiler.BeginScope("sprites");
+					queue.Draw(*renderer, camera.View(), camera.Projection(), texture.PremultipliedAlpha());
+					gpuProfiler.EndScope();
+					double cpuTime = cpuTimer.Elapsed();
+
+					gpuProfiler.EndFrame();
+
+					// Waiting for the GPU makes the frame time include the actual rendering
+					glFinish();
+					double frameTime = frameTimer.Elapsed();
+
+					if (frame >= 0)
+					{
+						sortTotal += sortTime;
+						cpuTotal += cpuTime;
+						frameTotal += frameTime;
+					}
+
+					GraphicsPresent(window);
+				}
+
+				const SpriteRenderStats& stats = renderer->Stats();
+				const double frames{ static_cast<double>(frameCount) };
+				std::cout << std::format("{:<14}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.0f}{:>14.1f}\n",
+					ToString(backend),
+					sortTotal / frames * 1000.0,
+					cpuTotal / frames * 1000.0,
+					gpuProfiler.Passes().empty() ? 0.0 : gpuProfiler.Passes().front().MeanMs(),
+					frameTotal / frames * 1000.0,
+					static_cast<double>(stats.drawCalls) / frames,
+					static_cast<double>(stats.bytesUploaded) / frames / 1024.0);
+
+				// The ring keeps the last frames only, enough for the per-call ratios
+				if (PerfCounters::Enabled())
+					std::cout << FormatZoneSummary(CpuProfiler::Instance().SummarizeZones(measuredSince)) << '\n';
+			}
+		}
+
+		GraphicsShutdown();
+		return 0;
+	}
+}
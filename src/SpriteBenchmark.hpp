@@ -0,0 +1,15 @@
+#pragma once
+#include "GameEngine/Renderer.hpp"
+#include "GameEngine/SpriteRenderer.hpp"
+#include <span>
+
+namespace GameEngine
+{
+	// Draws spriteCount moving sprites for frameCount frames with each of the backends
+	// and prints the average CPU submit time, frame time and upload volume of each one.
+	// headless renders offscreen without a window (see GraphicsInit),
+	// SplitPasses draws the opaque sprites front to back before the translucent ones
+	int RunSpriteBenchmark(int winWidth, int winHeight, int spriteCount, int frameCount,
+		std::span<const SpriteBackend> backends = AllSpriteBackends, bool headless = false,
+		Renderer::DepthMode depthMode = Renderer::DepthMode::Painter2D);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+in vec4 FragColor;
+
+out vec4 OutColor;
+
+void main()
+{
+	OutColor = FragColor;
+}
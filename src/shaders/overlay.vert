@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) in vec2 Position;
+layout(location = 1) in vec4 Color;
+
+// xy - window size in pixels
+uniform vec4 windowSize;
+
+out vec4 FragColor;
+
+void main()
+{
+	// Pixels with the top-left origin to NDC
+	vec2 ndc = Position / windowSize.xy * 2.0 - 1.0;
+	gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+	FragColor = Color;
+}
@@ -0,0 +1,27 @@
+#version 330 core
+
+in vec2 FragTexPos;
+in vec4 FragTint;
+
+uniform sampler2D spriteTexture;
+uniform sampler2D spritePalette;
+uniform bool paletteMode;
+uniform float alphaCutoff;
+
+out vec4 OutColor;
+
+void main()
+{
+	// Palettized sprites store an index in the red channel, the palette has the color
+	vec4 color;
+	if (paletteMode)
+		color = texelFetch(spritePalette, ivec2(int(texture(spriteTexture, FragTexPos).r * 255.0 + 0.5), 0), 0);
+	else
+		color = texture(spriteTexture, FragTexPos);
+
+	OutColor = color * FragTint;
+
+	// Alpha test of the opaque/cutout pass, it replaces blending so those sprites can write depth
+	if (OutColor.a < alphaCutoff)
+		discard;
+}
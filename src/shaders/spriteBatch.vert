@@ -0,0 +1,18 @@
+#version 330 core
+
+layout(location = 0) in vec3 Position;
+layout(location = 1) in vec2 TexPos;
+layout(location = 2) in vec4 Tint;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 FragTexPos;
+out vec4 FragTint;
+
+void main()
+{
+	gl_Position = projection * view * vec4(Position, 1.0);
+	FragTexPos = TexPos;
+	FragTint = Tint;
+}
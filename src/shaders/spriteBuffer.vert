@@ -0,0 +1,60 @@
+#version 330 core
+
+// Two texels per sprite:
+//  [0] = position.xyz, rotation (float bits)
+//  [1] = size (2 x half), uv0 (2 x unorm16), uv1 (2 x unorm16), tint (RGBA8)
+uniform usamplerBuffer spriteData;
+
+uniform bool instanced;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 FragTexPos;
+out vec4 FragTint;
+
+// Triangle list corners for the non-instanced path, triangle strip uses the first four
+const vec2 corners[6] = vec2[](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(0.0, 1.0), vec2(1.0, 0.0));
+
+// GLSL 3.30 has no unpackHalf2x16
+float HalfToFloat(uint bits)
+{
+	uint exponent = (bits >> 10u) & 0x1Fu;
+	float mantissa = float(bits & 0x3FFu);
+	float value = exponent == 0u
+		? mantissa * exp2(-24.0)
+		: (1.0 + mantissa / 1024.0) * exp2(float(exponent) - 15.0);
+
+	return (bits & 0x8000u) != 0u ? -value : value;
+}
+
+vec2 UnpackUnorm16(uint bits)
+{
+	return vec2(float(bits & 0xFFFFu), float(bits >> 16u)) / 65535.0;
+}
+
+vec4 UnpackUnorm8(uint bits)
+{
+	return vec4(float(bits & 0xFFu), float((bits >> 8u) & 0xFFu), float((bits >> 16u) & 0xFFu), float(bits >> 24u)) / 255.0;
+}
+
+void main()
+{
+	int sprite = instanced ? gl_InstanceID : gl_VertexID / 6;
+	vec2 corner = corners[instanced ? gl_VertexID : gl_VertexID % 6];
+
+	uvec4 transform = texelFetch(spriteData, sprite * 2);
+	uvec4 attributes = texelFetch(spriteData, sprite * 2 + 1);
+
+	vec3 center = uintBitsToFloat(transform.xyz);
+	float rotation = uintBitsToFloat(transform.w);
+	vec2 size = vec2(HalfToFloat(attributes.x & 0xFFFFu), HalfToFloat(attributes.x >> 16u));
+
+	vec2 offset = (corner - 0.5) * size;
+	float c = cos(rotation);
+	float s = sin(rotation);
+	vec2 rotated = vec2(c * offset.x - s * offset.y, s * offset.x + c * offset.y);
+
+	gl_Position = projection * view * vec4(center.xy + rotated, center.z, 1.0);
+	FragTexPos = mix(UnpackUnorm16(attributes.y), UnpackUnorm16(attributes.z), corner);
+	FragTint = UnpackUnorm8(attributes.w);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+
+layout(location = 0) in vec2 Position;		// int16 steps around positionOrigin
+layout(location = 1) in vec2 TexPos;		// unorm16
+layout(location = 2) in vec4 Tint;			// unorm8
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec4 positionOrigin;
+uniform float positionStep;
+
+out vec2 FragTexPos;
+out vec4 FragTint;
+
+// No depth, painter mode only
+void main()
+{
+	gl_Position = projection * view * vec4(positionOrigin.xy + Position * positionStep, 0.0, 1.0);
+	FragTexPos = TexPos;
+	FragTint = Tint;
+}
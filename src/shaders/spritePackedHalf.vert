@@ -0,0 +1,20 @@
+#version 330 core
+
+layout(location = 0) in vec2 Position;		// half-float
+layout(location = 1) in vec2 TexPos;		// unorm16
+layout(location = 2) in vec4 Tint;			// unorm8
+layout(location = 3) in uvec2 LayerIndex;	// layer and sub-image index
+layout(location = 4) in float Depth;		// unorm16
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 FragTexPos;
+out vec4 FragTint;
+
+void main()
+{
+	gl_Position = projection * view * vec4(Position, Depth, 1.0);
+	FragTexPos = TexPos;
+	FragTint = Tint;
+}
@@ -0,0 +1,24 @@
+#version 330 core
+
+layout(location = 0) in vec3 Position;
+layout(location = 1) in vec2 Size;
+layout(location = 2) in float Rotation;
+layout(location = 3) in vec4 UVRect;
+layout(location = 4) in vec4 Tint;
+
+out SpritePoint
+{
+	vec2 Size;
+	float Rotation;
+	vec4 UVRect;
+	vec4 Tint;
+} point;
+
+void main()
+{
+	gl_Position = vec4(Position, 1.0);
+	point.Size = Size;
+	point.Rotation = Rotation;
+	point.UVRect = UVRect;
+	point.Tint = Tint;
+}
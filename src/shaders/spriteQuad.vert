@@ -0,0 +1,20 @@
+#version 330 core
+
+layout(location = 0) in vec3 Position;
+layout(location = 1) in vec2 TexPos;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec4 uvRect;
+uniform vec4 tint;
+
+out vec2 FragTexPos;
+out vec4 FragTint;
+
+void main()
+{
+	gl_Position = projection * view * model * vec4(Position, 1.0);
+	FragTexPos = mix(uvRect.xy, uvRect.zw, TexPos);
+	FragTint = tint;
+}
@@ -0,0 +1,18 @@
+#version 330 core
+
+in vec2 FragTexPos;
+flat in uint FragLayer;
+
+uniform sampler2DArray tileTexture;
+uniform float alphaCutoff;
+
+out vec4 OutColor;
+
+void main()
+{
+	OutColor = texture(tileTexture, vec3(FragTexPos, float(FragLayer)));
+
+	// Cutout tiles (fences, decorations) over the ground
+	if (OutColor.a < alphaCutoff)
+		discard;
+}
@@ -0,0 +1,27 @@
+#version 330 core
+
+// Per instance, one tile
+layout(location = 0) in ivec2 Cell;			// int16 grid cell
+layout(location = 1) in uvec2 LayerFlags;	// texture array layer, flip flags
+
+uniform vec4 grid;		// origin.xy, cell size.zw
+uniform float depth;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 FragTexPos;
+flat out uint FragLayer;
+
+// Triangle strip of the quad
+const vec2 corners[4] = vec2[](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0));
+
+void main()
+{
+	vec2 corner = corners[gl_VertexID];
+
+	gl_Position = projection * view * vec4(grid.xy + (vec2(Cell) + corner) * grid.zw, depth, 1.0);
+
+	// The layer is the whole texture, so the UVs are just the corner
+	FragTexPos = vec2((LayerFlags.y & 1u) != 0u ? 1.0 - corner.x : corner.x, (LayerFlags.y & 2u) != 0u ? 1.0 - corner.y : corner.y);
+	FragLayer = LayerFlags.x;
+}